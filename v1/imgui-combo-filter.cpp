@@ -6,16 +6,48 @@
 namespace ImGui
 {
 
+namespace Internal
+{
+
+struct ComboTraceHooks
+{
+    ComboTraceHookCallback Begin    = nullptr;
+    ComboTraceHookCallback End      = nullptr;
+    void*                  UserData = nullptr;
+};
+
+static ComboTraceHooks gComboTraceHooks{ };
+[[maybe_unused]] static ImGuiID gComboTraceSearchID = 0; // Combo being searched, reported with the sort events (unused when tracing is compiled out)
+
+}
+
 void SortFilterResultsDescending(ComboFilterSearchResults& filtered_items)
 {
+    IMGUI_COMBO_TRACE_SCOPE(ComboTracePhase_Sort, Internal::gComboTraceSearchID);
     std::sort(filtered_items.rbegin(), filtered_items.rend());
 }
 
 void SortFilterResultsAscending(ComboFilterSearchResults& filtered_items)
 {
+    IMGUI_COMBO_TRACE_SCOPE(ComboTracePhase_Sort, Internal::gComboTraceSearchID);
     std::sort(filtered_items.begin(), filtered_items.end());
 }
 
+void SetComboTraceHooks(ComboTraceHookCallback begin_hook, ComboTraceHookCallback end_hook, void* user_data)
+{
+    Internal::gComboTraceHooks.Begin = begin_hook;
+    Internal::gComboTraceHooks.End = end_hook;
+    Internal::gComboTraceHooks.UserData = user_data;
+}
+
+const char* GetComboTracePhaseName(ComboTracePhase phase)
+{
+    static const char* const names[]{ "ComboPopupSetup", "ComboSearch", "ComboSort", "ComboClipper" };
+    static_assert(IM_ARRAYSIZE(names) == ComboTracePhase_COUNT);
+    IM_ASSERT(phase >= 0 && phase < ComboTracePhase_COUNT);
+    return names[phase];
+}
+
 namespace Internal
 {
 
@@ -52,6 +84,24 @@ void SetScrollToComboItemDown(ImGuiWindow* listbox_window, int index)
         listbox_window->Scroll.y += diff + 1.0f;
 }
 
+#ifdef IMGUI_COMBO_FILTER_ENABLE_TRACING
+void ComboTraceBegin(ComboTracePhase phase, ImGuiID combo_id)
+{
+    if (phase == ComboTracePhase_Search)
+        gComboTraceSearchID = combo_id;
+    if (gComboTraceHooks.Begin)
+        gComboTraceHooks.Begin(phase, combo_id, gComboTraceHooks.UserData);
+}
+
+void ComboTraceEnd(ComboTracePhase phase, ImGuiID combo_id)
+{
+    if (gComboTraceHooks.End)
+        gComboTraceHooks.End(phase, combo_id, gComboTraceHooks.UserData);
+    if (phase == ComboTracePhase_Search)
+        gComboTraceSearchID = 0;
+}
+#endif
+
 void UpdateInputTextAndCursor(char* buf, int buf_capacity, const char* new_str)
 {
     strncpy(buf, new_str, buf_capacity);
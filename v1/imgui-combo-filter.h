@@ -60,6 +60,23 @@ using ComboFilterSearchCallback = void (*)(const ComboFilterSearchCallbackData<T
 void SortFilterResultsDescending(ComboFilterSearchResults& filtered_items);
 void SortFilterResultsAscending(ComboFilterSearchResults& filtered_items);
 
+// Tracing hooks
+// Begin/end events emitted around the phases of the widgets, so they can be forwarded to an external profiler/tracer
+// The events are only emitted if IMGUI_COMBO_FILTER_ENABLE_TRACING is defined, otherwise they are compiled out and the hooks are never called
+// combo_id is the id of the widget. For ComboTracePhase_Sort it is the id of the combo being searched, or 0 when sorting outside of a search
+enum ComboTracePhase
+{
+	ComboTracePhase_PopupSetup, // Popup size constraints, positioning and Begin()
+	ComboTracePhase_Search,     // The search callback invocation, sort included
+	ComboTracePhase_Sort,       // SortFilterResultsDescending/Ascending
+	ComboTracePhase_Clipper,    // The ImGuiListClipper loop listing the items
+	ComboTracePhase_COUNT
+};
+using ComboTraceHookCallback = void (*)(ComboTracePhase phase, ImGuiID combo_id, void* user_data);
+
+void SetComboTraceHooks(ComboTraceHookCallback begin_hook, ComboTraceHookCallback end_hook, void* user_data = NULL);
+const char* GetComboTracePhaseName(ComboTracePhase phase);
+
 // Combo box with text filter
 // T1 should be a container.
 // T2 can be, but not necessarily, the same as T1 but it should be convertible from T1 (e.g. std::vector<...> -> std::span<...>)
@@ -80,6 +97,29 @@ void SetScrollToComboItemUp(ImGuiWindow* listbox_window, int index);
 void SetScrollToComboItemDown(ImGuiWindow* listbox_window, int index);
 void UpdateInputTextAndCursor(char* buf, int buf_capacity, const char* new_str);
 
+// Tracing helpers for the widgets
+#ifdef IMGUI_COMBO_FILTER_ENABLE_TRACING
+void ComboTraceBegin(ComboTracePhase phase, ImGuiID combo_id);
+void ComboTraceEnd(ComboTracePhase phase, ImGuiID combo_id);
+
+struct ComboTraceScope
+{
+	ComboTracePhase Phase;
+	ImGuiID         ComboID;
+
+	ComboTraceScope(ComboTracePhase phase, ImGuiID combo_id) : Phase(phase), ComboID(combo_id) { ComboTraceBegin(Phase, ComboID); }
+	~ComboTraceScope() { ComboTraceEnd(Phase, ComboID); }
+};
+
+#define IMGUI_COMBO_TRACE_BEGIN(_PHASE, _ID) ImGui::Internal::ComboTraceBegin(_PHASE, _ID)
+#define IMGUI_COMBO_TRACE_END(_PHASE, _ID)   ImGui::Internal::ComboTraceEnd(_PHASE, _ID)
+#define IMGUI_COMBO_TRACE_SCOPE(_PHASE, _ID) ImGui::Internal::ComboTraceScope IM_CONCAT(combo_trace_scope_, __LINE__)(_PHASE, _ID)
+#else
+#define IMGUI_COMBO_TRACE_BEGIN(_PHASE, _ID) ((void)0)
+#define IMGUI_COMBO_TRACE_END(_PHASE, _ID)   ((void)0)
+#define IMGUI_COMBO_TRACE_SCOPE(_PHASE, _ID) ((void)0)
+#endif
+
 // Created my own std::size and std::empty implementation to avoid additional header dependency
 template<typename T>
 constexpr auto GetContainerSize(const T& item);
@@ -308,6 +348,7 @@ bool ComboAutoSelectEX(const char* combo_label, char* input_text, int input_capa
 	if (!popupIsAlreadyOpened)
 		return false;
 
+	IMGUI_COMBO_TRACE_BEGIN(ComboTracePhase_PopupSetup, popupId);
 	const float popup_width = (flags & (ImGuiComboFlags_NoPreview | ImGuiComboFlags_NoArrowButton)) ? expected_w : w - arrow_size;
 	int popup_item_count = -1;
 	if (!(g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasSizeConstraint)) {
@@ -352,9 +393,11 @@ bool ComboAutoSelectEX(const char* combo_label, char* input_text, int input_capa
 		PopStyleVar();
 		PopItemWidth();
 		EndPopup();
+		IMGUI_COMBO_TRACE_END(ComboTracePhase_PopupSetup, popupId);
 		IM_ASSERT(0);   // This should never happen as we tested for IsPopupOpen() above
 		return false;
 	}
+	IMGUI_COMBO_TRACE_END(ComboTracePhase_PopupSetup, popupId);
 
 	PushItemWidth(GetWindowWidth());
 	SetCursorPos(ImVec2(0.f, window->DC.CurrLineTextBaseOffset));
@@ -384,6 +427,7 @@ bool ComboAutoSelectEX(const char* combo_label, char* input_text, int input_capa
 		ImGuiWindow* listbox_window = ImGui::GetCurrentWindow();
 		listbox_window->Flags |= listbox_flags;
 
+		IMGUI_COMBO_TRACE_BEGIN(ComboTracePhase_Clipper, popupId);
 		ImGuiListClipper list_clipper;
 		list_clipper.Begin(items_count);
 		char select_item_id[128];
@@ -405,6 +449,7 @@ bool ComboAutoSelectEX(const char* combo_label, char* input_text, int input_capa
 				}
 			}
 		}
+		IMGUI_COMBO_TRACE_END(ComboTracePhase_Clipper, popupId);
 
 		if (clicked_outside || IsKeyPressed(ImGuiKey_Escape)) { // Resets the selection to it's initial value if the user exits the combo (clicking outside the combo or the combo arrow button)
 			if (clicked_outside)
@@ -423,6 +468,7 @@ bool ComboAutoSelectEX(const char* combo_label, char* input_text, int input_capa
 			CloseCurrentPopup();
 		}
 		else if (buffer_changed) {
+			IMGUI_COMBO_TRACE_SCOPE(ComboTracePhase_Search, popupId);
 			selected_item = autoselect_callback({ items, input_text, item_getter });
 			if (selected_item < 0)
 				SetScrollY(0.0f);
@@ -528,6 +574,7 @@ bool ComboFilterEX(const char* combo_label, char* input_text, int input_capacity
 	if (!popup_open)
 		return false;
 
+	IMGUI_COMBO_TRACE_BEGIN(ComboTracePhase_PopupSetup, combo_id);
 	PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(3.50f, 5.00f));
 	int popup_item_count = -1;
 	if (!(g->NextWindowData.Flags & ImGuiNextWindowDataFlags_HasSizeConstraint)) {
@@ -560,9 +607,11 @@ bool ComboFilterEX(const char* combo_label, char* input_text, int input_capacity
 	if (!Begin(name, NULL, window_flags)) {
 		PopStyleVar();
 		EndPopup();
+		IMGUI_COMBO_TRACE_END(ComboTracePhase_PopupSetup, combo_id);
 		IM_ASSERT(0);   // This should never happen as we tested for IsPopupOpen() above
 		return false;
 	}
+	IMGUI_COMBO_TRACE_END(ComboTracePhase_PopupSetup, combo_id);
 
 	if (popup_just_opened) {
 		SetKeyboardFocusHere();
@@ -594,6 +643,7 @@ bool ComboFilterEX(const char* combo_label, char* input_text, int input_capacity
 		if (listbox_window->Appearing)
 			SetScrollToComboItemJump(listbox_window, preview_item);
 
+		IMGUI_COMBO_TRACE_BEGIN(ComboTracePhase_Clipper, combo_id);
 		ImGuiListClipper listclipper;
 		listclipper.Begin(item_count);
 		char select_item_id[128];
@@ -620,6 +670,7 @@ bool ComboFilterEX(const char* combo_label, char* input_text, int input_capacity
 				}
 			}
 		}
+		IMGUI_COMBO_TRACE_END(ComboTracePhase_Clipper, combo_id);
 
 		if (clicked_outside || IsKeyPressed(ImGuiKey_Escape)) {
 			selected_item = preview_item;
@@ -629,8 +680,10 @@ bool ComboFilterEX(const char* combo_label, char* input_text, int input_capacity
 		}
 		else if (buffer_changed) {
 			filtered_items.clear();
-			if (input_text[0] != '\0')
+			if (input_text[0] != '\0') {
+				IMGUI_COMBO_TRACE_SCOPE(ComboTracePhase_Search, combo_id);
 				filter_callback({ items, input_text, item_getter, &filtered_items });
+			}
 			selected_item = GetContainerSize(filtered_items) != 0 ? 0 : -1;
 			SetScrollY(0.0f);
 		}
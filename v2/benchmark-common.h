@@ -0,0 +1,89 @@
+// Helpers shared by the headless benchmark programs
+// A headless context has no platform or renderer backend: the font atlas is built on the CPU and the draw data is simply discarded
+
+#pragma once
+
+#include <stdlib.h>
+#include <chrono>
+#include "imgui.h"
+#include "imgui_internal.h"
+
+namespace Benchmark
+{
+
+inline double GetTimeSeconds()
+{
+    using clock = std::chrono::steady_clock;
+    return std::chrono::duration<double>(clock::now().time_since_epoch()).count();
+}
+
+// Allocations made through ImGui::MemAlloc(), counted with SetAllocatorFunctions()
+// Programs that want to count std containers as well should also replace the global operator new
+inline int gImGuiAllocCount = 0;
+
+inline void* CountingImGuiAlloc(size_t size, void*)
+{
+    ++gImGuiAllocCount;
+    return malloc(size);
+}
+
+inline void CountingImGuiFree(void* ptr, void*)
+{
+    free(ptr);
+}
+
+// Creates and destroys an ImGui context that can run frames without a backend
+struct HeadlessContext
+{
+    ImGuiContext* Context;
+
+    HeadlessContext(float display_w = 1280.0f, float display_h = 720.0f)
+    {
+        ImGui::SetAllocatorFunctions(CountingImGuiAlloc, CountingImGuiFree, nullptr);
+        Context = ImGui::CreateContext();
+
+        ImGuiIO& io = ImGui::GetIO();
+        io.DisplaySize = ImVec2(display_w, display_h);
+        io.DeltaTime = 1.0f / 60.0f;
+        io.IniFilename = nullptr;
+        io.LogFilename = nullptr;
+
+        unsigned char* pixels;
+        int width, height;
+        io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    }
+
+    ~HeadlessContext()
+    {
+        ImGui::DestroyContext(Context);
+    }
+};
+
+// Frame helpers simulating the input a user would produce
+// The events are queued before NewFrame() so they are processed in that frame
+
+inline void QueueMouseClick(const ImVec2& pos, bool down)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.AddMousePosEvent(pos.x, pos.y);
+    io.AddMouseButtonEvent(ImGuiMouseButton_Left, down);
+}
+
+inline void QueueMouseWheel(const ImVec2& pos, float wheel_y)
+{
+    ImGuiIO& io = ImGui::GetIO();
+    io.AddMousePosEvent(pos.x, pos.y);
+    io.AddMouseWheelEvent(0.0f, wheel_y);
+}
+
+inline void QueueKeyPress(ImGuiKey key, bool down)
+{
+    ImGui::GetIO().AddKeyEvent(key, down);
+}
+
+inline void QueueCharacter(unsigned int c)
+{
+    ImGui::GetIO().AddInputCharacter(c);
+}
+
+} // Benchmark namespace
@@ -0,0 +1,242 @@
+// Microbenchmark for the string matching kernels used by the search callbacks
+// Runs every registered kernel over generated corpora (file paths, C++ symbols, English words, mixed-script UTF-8)
+// for a sweep of query lengths, with queries that mostly hit (subsequences of items) and queries that mostly miss (random letters)
+// Then times SortFilterResultsDescending against std::sort over result sets of 1k to 5M scores
+//
+// No ImGui context is created, but the kernels live in imgui-combo-filter.cpp so it still links against the Dear ImGui core sources:
+//   c++ -std=c++20 -O2 -I<imgui> benchmark-matchers.cpp imgui-combo-filter.cpp <imgui>/imgui.cpp <imgui>/imgui_draw.cpp <imgui>/imgui_tables.cpp <imgui>/imgui_widgets.cpp -o benchmark-matchers
+// Usage:
+//   benchmark-matchers [item_count] [repeats]
+
+#include "imgui-combo-filter.h"
+#include "benchmark-common.h"
+#include "synthetic-corpus.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// KERNELS
+//----------------------------------------------------------------------------------------------------------------------
+
+using MatchKernel = bool (*)(const char* pattern, const char* haystack, int& out_score);
+
+static bool kernel_fuzzy_search(const char* pattern, const char* haystack, int& out_score)
+{
+    constexpr int max_matches = 128;
+    unsigned char matches[max_matches];
+    int match_count;
+    return ImGui::Internal::FuzzySearchEX(pattern, haystack, out_score, matches, max_matches, match_count);
+}
+
+static bool kernel_fuzzy_search_score_only(const char* pattern, const char* haystack, int& out_score)
+{
+    return ImGui::Internal::FuzzySearchEX(pattern, haystack, out_score);
+}
+
+// Lower bound for any subsequence matcher: a single greedy pass without scoring
+static bool kernel_subsequence(const char* pattern, const char* haystack, int& out_score)
+{
+    out_score = 0;
+    for (; *pattern != '\0' && *haystack != '\0'; ++haystack) {
+        if (tolower(*pattern) == tolower(*haystack))
+            ++pattern;
+    }
+    return *pattern == '\0';
+}
+
+static bool kernel_fuzzy_search_greedy(const char* pattern, const char* haystack, int& out_score)
+{
+    int pos;
+    return ImGui::Internal::FuzzySearchGreedy(pattern, haystack, 0, 128, pos, out_score);
+}
+
+static bool kernel_fuzzy_search_upper_bound(const char* pattern, const char* haystack, int& out_score)
+{
+    return ImGui::Internal::FuzzySearchScoreUpperBound(pattern, haystack, 128, out_score);
+}
+
+struct KernelEntry
+{
+    const char* Name;
+    MatchKernel Kernel;
+};
+
+static const KernelEntry Kernels[]{
+    { "FuzzySearchEX",              kernel_fuzzy_search },
+    { "FuzzySearchEX score-only",   kernel_fuzzy_search_score_only },
+    { "FuzzySearchGreedy",          kernel_fuzzy_search_greedy },
+    { "FuzzySearchScoreUpperBound", kernel_fuzzy_search_upper_bound },
+    { "greedy subsequence",         kernel_subsequence },
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// QUERIES
+//----------------------------------------------------------------------------------------------------------------------
+
+// A subsequence of a random item, cut on UTF-8 character boundaries so the query stays valid UTF-8
+static std::string MakeHitQuery(SyntheticCorpus::Random& rng, const std::vector<std::string>& items, int length)
+{
+    const std::string& item = items[rng.Range(static_cast<int>(items.size()))];
+    std::vector<int> starts;
+    for (int i = 0; i < static_cast<int>(item.size()); ++i) {
+        if ((static_cast<unsigned char>(item[i]) & 0xC0) != 0x80)
+            starts.push_back(i);
+    }
+
+    std::string query;
+    int taken = 0;
+    const int char_count = static_cast<int>(starts.size());
+    for (int c = 0; c < char_count && taken < length; ++c) {
+        // Keep each remaining character with the probability needed to end up with 'length' characters
+        if (rng.Range(char_count - c) < length - taken) {
+            const int end = c + 1 < char_count ? starts[c + 1] : static_cast<int>(item.size());
+            query.append(item, starts[c], end - starts[c]);
+            ++taken;
+        }
+    }
+    return query;
+}
+
+static std::string MakeMissQuery(SyntheticCorpus::Random& rng, int length)
+{
+    std::string query;
+    for (int i = 0; i < length; ++i)
+        query += static_cast<char>('a' + rng.Range(26));
+    return query;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// BENCHMARK
+//----------------------------------------------------------------------------------------------------------------------
+
+struct Corpus
+{
+    const char*              Name;
+    std::vector<std::string> Items;
+    std::vector<const char*> Pointers;
+};
+
+static Corpus MakeCorpus(const char* name, std::vector<std::string>&& items)
+{
+    Corpus corpus{ name, std::move(items), {} };
+    corpus.Pointers.reserve(corpus.Items.size());
+    for (const std::string& item : corpus.Items)
+        corpus.Pointers.push_back(item.c_str());
+    return corpus;
+}
+
+static volatile unsigned gSink = 0; // Keeps the compiler from dropping the kernel calls
+
+// Returns the best time over 'repeats' runs of every query against every item, and the number of hits of a single run
+static double TimeKernel(MatchKernel kernel, const Corpus& corpus, const std::vector<std::string>& queries, int repeats, long long& out_hits)
+{
+    double best = 1e30;
+    for (int r = 0; r < repeats; ++r) {
+        long long hits = 0;
+        unsigned score_sum = 0; // Wraps around instead of overflowing on the large corpora
+        const double t0 = Benchmark::GetTimeSeconds();
+        for (const std::string& query : queries) {
+            for (const char* item : corpus.Pointers) {
+                int score;
+                if (kernel(query.c_str(), item, score)) {
+                    ++hits;
+                    score_sum += static_cast<unsigned>(score);
+                }
+            }
+        }
+        const double t = Benchmark::GetTimeSeconds() - t0;
+        gSink = gSink + score_sum;
+        best = t < best ? t : best;
+        out_hits = hits;
+    }
+    return best;
+}
+
+// Returns the best time over 'repeats' sorts of copies of 'results'
+template<typename SortFunc>
+static double TimeSort(SortFunc&& sort_func, const ImGui::ComboFilterSearchResults& results, int repeats)
+{
+    double best = 1e30;
+    ImGui::ComboFilterSearchResults copy;
+    for (int r = 0; r < repeats; ++r) {
+        copy = results;
+        const double t0 = Benchmark::GetTimeSeconds();
+        sort_func(copy);
+        const double t = Benchmark::GetTimeSeconds() - t0;
+        gSink = gSink + copy.front().Index;
+        best = t < best ? t : best;
+    }
+    return best;
+}
+
+static void RunSortBenchmark(int repeats)
+{
+    printf("\n%9s  %-28s %10s %12s\n", "results", "sort", "ns/result", "Mresults/s");
+    const int result_counts[]{ 1000, 10000, 100000, 1000000, 5000000 };
+    for (int count : result_counts) {
+        // Fuzzy scores span a few hundred values, so most results tie with others
+        SyntheticCorpus::Random rng(static_cast<uint64_t>(count));
+        ImGui::ComboFilterSearchResults results;
+        results.reserve(count);
+        for (int i = 0; i < count; ++i)
+            results.emplace_back(i, rng.Range(400) - 100);
+
+        const double t_radix = TimeSort([](ImGui::ComboFilterSearchResults& r) { ImGui::SortFilterResultsDescending(r); }, results, repeats);
+        const double t_std = TimeSort([](ImGui::ComboFilterSearchResults& r) { std::sort(r.rbegin(), r.rend()); }, results, repeats);
+        printf("%9d  %-28s %10.2f %12.2f\n", count, "SortFilterResultsDescending", t_radix / count * 1e9, count / t_radix * 1e-6);
+        printf("%9d  %-28s %10.2f %12.2f\n", count, "std::sort", t_std / count * 1e9, count / t_std * 1e-6);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    const int item_count = argc > 1 ? atoi(argv[1]) : 100000;
+    const int repeats = argc > 2 ? atoi(argv[2]) : 3;
+    constexpr int queries_per_case = 8;
+    const int query_lengths[]{ 1, 2, 3, 5, 8, 13 };
+
+    const Corpus corpora[]{
+        MakeCorpus("paths",   SyntheticCorpus::GenerateFilePaths(item_count)),
+        MakeCorpus("symbols", SyntheticCorpus::GenerateSymbols(item_count)),
+        MakeCorpus("words",   SyntheticCorpus::GenerateWords(item_count)),
+        MakeCorpus("utf8",    SyntheticCorpus::GenerateMixedUtf8(item_count)),
+    };
+
+    printf("%d items per corpus, %d queries per case, best of %d runs\n", item_count, queries_per_case, repeats);
+    printf("%-8s %-5s %4s %7s  %-26s %10s %12s\n", "corpus", "kind", "qlen", "hits", "kernel", "ns/item", "Mitems/s");
+
+    for (const Corpus& corpus : corpora) {
+        for (int length : query_lengths) {
+            for (int kind = 0; kind < 2; ++kind) {
+                SyntheticCorpus::Random rng(static_cast<uint64_t>(length * 2 + kind));
+                std::vector<std::string> queries;
+                for (int q = 0; q < queries_per_case; ++q)
+                    queries.push_back(kind == 0 ? MakeHitQuery(rng, corpus.Items, length) : MakeMissQuery(rng, length));
+
+                const double comparisons = static_cast<double>(queries.size()) * static_cast<double>(corpus.Pointers.size());
+                for (const KernelEntry& entry : Kernels) {
+                    long long hits = 0;
+                    const double t = TimeKernel(entry.Kernel, corpus, queries, repeats, hits);
+                    printf("%-8s %-5s %4d %6.2f%%  %-26s %10.2f %12.2f\n",
+                        corpus.Name,
+                        kind == 0 ? "hit" : "miss",
+                        length,
+                        100.0 * static_cast<double>(hits) / comparisons,
+                        entry.Name,
+                        t / comparisons * 1e9,
+                        comparisons / t * 1e-6
+                    );
+                }
+            }
+        }
+    }
+
+    RunSortBenchmark(repeats);
+
+    return 0;
+}
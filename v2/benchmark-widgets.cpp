@@ -0,0 +1,261 @@
+// Headless end-to-end benchmark for ComboFilter and ComboAutoSelect
+// Types a query into an open combo popup one character per frame, then erases it, and reports the frame cost per keystroke
+// Then scrolls the unfiltered list with the mouse wheel, to measure the cost of listing the rows alone
+//
+// Build it together with the Dear ImGui core sources, no backend is needed:
+//   c++ -std=c++20 -O2 -I<imgui> benchmark-widgets.cpp imgui-combo-filter.cpp <imgui>/imgui.cpp <imgui>/imgui_draw.cpp <imgui>/imgui_tables.cpp <imgui>/imgui_widgets.cpp -o benchmark-widgets
+// Usage:
+//   benchmark-widgets [max_item_count] [query]
+
+#include "imgui-combo-filter.h"
+#include "benchmark-common.h"
+#include "synthetic-corpus.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <new>
+#include <span>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// ALLOCATION COUNTING
+//----------------------------------------------------------------------------------------------------------------------
+
+static int gNewCount = 0;
+
+void* operator new(size_t size)
+{
+    ++gNewCount;
+    if (void* ptr = malloc(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+static int GetAllocCount()
+{
+    return gNewCount + Benchmark::gImGuiAllocCount;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// TIMED CALLBACKS
+//----------------------------------------------------------------------------------------------------------------------
+
+struct FrameTimings
+{
+    double Filter = 0.0;
+    double Sort   = 0.0;
+};
+
+static FrameTimings gFrameTimings;
+
+static const char* item_getter(std::span<const std::string> items, int index)
+{
+    if (index >= 0 && index < (int)items.size()) {
+        return items[index].c_str();
+    }
+    return "";
+}
+
+// Mirrors DefaultComboFilterSearchCallback so the search and the sort can be timed separately
+static void timed_filter_search(const ImGui::ComboFilterSearchCallbackData<std::span<const std::string>>& cbd)
+{
+    const double t0 = Benchmark::GetTimeSeconds();
+    const int item_count = static_cast<int>(cbd.Items.size());
+    constexpr int max_matches = 128;
+    int upper_bound;
+    auto search_item = [&](int i) {
+        if (ImGui::Internal::FuzzySearchScoreUpperBound(cbd.SearchString, cbd.ItemGetter(cbd.Items, i), max_matches, upper_bound))
+            cbd.FilterResults->emplace_back(i, upper_bound);
+    };
+    if (cbd.PreviousResults) {
+        ImVector<int> candidates;
+        ImGui::Internal::GetComboNarrowedCandidates(*cbd.PreviousResults, candidates);
+        for (int i : candidates)
+            search_item(i);
+    }
+    else {
+        for (int i = 0; i < item_count; ++i)
+            search_item(i);
+    }
+    const double t1 = Benchmark::GetTimeSeconds();
+    ImGui::SortFilterResultsDescending(*cbd.FilterResults);
+    const double t2 = Benchmark::GetTimeSeconds();
+    ImGui::ComboFilterRanking ranking{ 0, 0 };
+    const int exact_count = cbd.Ranking ? ImGui::ComboFilterRanking::InitialExactCount : static_cast<int>(cbd.FilterResults->size());
+    ImGui::Internal::RefineComboFilterResults(*cbd.FilterResults, ranking, exact_count, cbd.SearchString, [&](int index) { return cbd.ItemGetter(cbd.Items, index); });
+    if (cbd.Ranking)
+        *cbd.Ranking = ranking;
+    const double t3 = Benchmark::GetTimeSeconds();
+
+    gFrameTimings.Filter += (t1 - t0) + (t3 - t2);
+    gFrameTimings.Sort += t2 - t1;
+}
+
+static int timed_autoselect_search(const ImGui::ComboAutoSelectSearchCallbackData<std::span<const std::string>>& cbd)
+{
+    const double t0 = Benchmark::GetTimeSeconds();
+    const int ret = ImGui::Internal::DefaultComboAutoSelectSearchCallback(cbd);
+    gFrameTimings.Filter += Benchmark::GetTimeSeconds() - t0;
+    return ret;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// BENCHMARK
+//----------------------------------------------------------------------------------------------------------------------
+
+enum WidgetKind
+{
+    WidgetKind_ComboFilter,
+    WidgetKind_ComboAutoSelect,
+};
+
+struct BenchmarkResult
+{
+    int    Frames       = 0;
+    int    Keystrokes   = 0;
+    double FrameTotal   = 0.0;
+    double FrameMax     = 0.0;
+    double FilterTotal  = 0.0;
+    double SortTotal    = 0.0;
+    int    Allocations  = 0;
+    int    ScrollFrames = 0;
+    double ScrollTotal  = 0.0; // Frames scrolling the full list, which only lays out and draws the rows
+};
+
+static constexpr const char* ComboLabel = "##benchmark_combo";
+
+// Runs a single frame with the combo in a fullscreen window and returns the rectangle of the combo
+static ImRect RunFrame(WidgetKind kind, const std::vector<std::string>& items, ImGuiComboFlags flags, int& selected_item, bool clear_combo_data = false)
+{
+    ImGui::NewFrame();
+    ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+    ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+    ImGui::Begin("Benchmark", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings);
+    if (kind == WidgetKind_ComboFilter)
+        ImGui::ComboFilter(ComboLabel, selected_item, items, item_getter, timed_filter_search, flags);
+    else
+        ImGui::ComboAutoSelect(ComboLabel, selected_item, items, item_getter, timed_autoselect_search, flags);
+    const ImRect rect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+    if (clear_combo_data)
+        ImGui::ClearComboData(ComboLabel);
+    ImGui::End();
+    ImGui::Render();
+    return rect;
+}
+
+static BenchmarkResult RunBenchmark(WidgetKind kind, const std::vector<std::string>& items, const char* query, ImGuiComboFlags flags)
+{
+    Benchmark::HeadlessContext context;
+    int selected_item = -1;
+
+    // Open the popup with a click so the input text gets the keyboard focus like it would for a user
+    const ImRect rect = RunFrame(kind, items, flags, selected_item);
+    const ImVec2 click_pos((rect.Min.x + rect.Max.x) * 0.5f, (rect.Min.y + rect.Max.y) * 0.5f);
+    Benchmark::QueueMouseClick(click_pos, true);
+    RunFrame(kind, items, flags, selected_item);
+    Benchmark::QueueMouseClick(click_pos, false);
+    RunFrame(kind, items, flags, selected_item);
+    RunFrame(kind, items, flags, selected_item);
+
+    // Every keystroke is measured over two frames: the one processing the input (and running the search)
+    // and the next one laying out the new results
+    BenchmarkResult result;
+    auto measure_keystroke = [&](auto&& queue_input) {
+        for (int frame = 0; frame < 2; ++frame) {
+            queue_input(frame);
+            gFrameTimings = FrameTimings();
+            const int allocs_before = GetAllocCount();
+            const double t0 = Benchmark::GetTimeSeconds();
+            RunFrame(kind, items, flags, selected_item);
+            const double frame_time = Benchmark::GetTimeSeconds() - t0;
+
+            result.Frames += 1;
+            result.FrameTotal += frame_time;
+            result.FrameMax = frame_time > result.FrameMax ? frame_time : result.FrameMax;
+            result.FilterTotal += gFrameTimings.Filter;
+            result.SortTotal += gFrameTimings.Sort;
+            result.Allocations += GetAllocCount() - allocs_before;
+        }
+        result.Keystrokes += 1;
+    };
+
+    for (const char* c = query; *c != '\0'; ++c) {
+        measure_keystroke([c](int frame) {
+            if (frame == 0)
+                Benchmark::QueueCharacter(static_cast<unsigned char>(*c));
+        });
+    }
+    for (const char* c = query; *c != '\0'; ++c) {
+        measure_keystroke([](int frame) {
+            Benchmark::QueueKeyPress(ImGuiKey_Backspace, frame == 0);
+        });
+    }
+
+    // Scroll down the unfiltered list with the mouse wheel over the list box
+    constexpr int scroll_frames = 32;
+    const ImVec2 wheel_pos(click_pos.x, rect.Max.y + ImGui::GetFrameHeightWithSpacing() * 2.0f);
+    for (int frame = 0; frame < scroll_frames; ++frame) {
+        Benchmark::QueueMouseWheel(wheel_pos, -5.0f);
+        const double t0 = Benchmark::GetTimeSeconds();
+        RunFrame(kind, items, flags, selected_item);
+        result.ScrollTotal += Benchmark::GetTimeSeconds() - t0;
+        result.ScrollFrames += 1;
+    }
+
+    Benchmark::QueueKeyPress(ImGuiKey_Escape, true);
+    RunFrame(kind, items, flags, selected_item);
+    Benchmark::QueueKeyPress(ImGuiKey_Escape, false);
+    RunFrame(kind, items, flags, selected_item, true);
+
+    return result;
+}
+
+static void PrintResult(const char* widget_name, int item_count, ImGuiComboFlags flags, const BenchmarkResult& r)
+{
+    const double frames = r.Frames > 0 ? r.Frames : 1;
+    const double keystrokes = r.Keystrokes > 0 ? r.Keystrokes : 1;
+    const double layout = r.FrameTotal - r.FilterTotal - r.SortTotal;
+    printf("%-16s %9d %6s %10.3f %10.3f %10.3f %12.3f %10.3f %12.1f %10.3f\n",
+        widget_name,
+        item_count,
+        (flags & ImGuiComboFlags_HeightLargest) ? "max" : "reg",
+        r.FrameTotal / frames * 1e3,
+        r.FrameMax * 1e3,
+        layout / frames * 1e3,
+        r.FilterTotal / keystrokes * 1e3,
+        r.SortTotal / keystrokes * 1e3,
+        r.Allocations / keystrokes,
+        r.ScrollTotal / (r.ScrollFrames > 0 ? r.ScrollFrames : 1) * 1e3
+    );
+}
+
+int main(int argc, char** argv)
+{
+    const int max_item_count = argc > 1 ? atoi(argv[1]) : 1000000;
+    const char* query = argc > 2 ? argv[2] : "mat_ste";
+
+    printf("query \"%s\", times in milliseconds\n", query);
+    printf("%-16s %9s %6s %10s %10s %10s %12s %10s %12s %10s\n", "widget", "items", "popup", "frame avg", "frame max", "layout avg", "filter/key", "sort/key", "allocs/key", "scroll avg");
+
+    const ImGuiComboFlags popup_flags[]{ ImGuiComboFlags_None, ImGuiComboFlags_HeightLargest };
+    for (int item_count = 1000; item_count <= max_item_count; item_count *= 10) {
+        const std::vector<std::string> items = SyntheticCorpus::GenerateIdentifiers(item_count);
+        for (ImGuiComboFlags flags : popup_flags) {
+            PrintResult("ComboFilter", item_count, flags, RunBenchmark(WidgetKind_ComboFilter, items, query, flags));
+            PrintResult("ComboAutoSelect", item_count, flags, RunBenchmark(WidgetKind_ComboAutoSelect, items, query, flags));
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,308 @@
+// Differential conformance harness for the string matching engines
+// Every registered engine is run against the reference FuzzySearchEX on randomized queries and haystacks
+// (generated items, random bytes, mixed UTF-8, empty strings, 255+ byte haystacks and over-long queries)
+// and must agree with it on match/no-match, and optionally on the score and the match positions
+// Any divergence is minimized before being reported, and the program exits with a non-zero code
+//
+// No ImGui context is created, but the reference lives in imgui-combo-filter.cpp so it still links against the Dear ImGui core sources:
+//   c++ -std=c++20 -O2 -I<imgui> conformance-matchers.cpp imgui-combo-filter.cpp <imgui>/imgui.cpp <imgui>/imgui_draw.cpp <imgui>/imgui_tables.cpp <imgui>/imgui_widgets.cpp -o conformance-matchers
+// Usage:
+//   conformance-matchers [iterations] [seed]
+
+#include "imgui-combo-filter.h"
+#include "synthetic-corpus.h"
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// ENGINES
+//----------------------------------------------------------------------------------------------------------------------
+
+// Same signature as the reference, out_matches/out_match_count can be left untouched by engines that don't check positions
+using MatchEngine = bool (*)(const char* pattern, const char* haystack, int& out_score, unsigned char out_matches[], int max_matches, int& out_match_count);
+
+enum EngineCheckFlags
+{
+    EngineCheck_Match           = 0,      // Match/no-match is always checked
+    EngineCheck_Score           = 1 << 0,
+    EngineCheck_Positions       = 1 << 1,
+    EngineCheck_ScoreUpperBound = 1 << 2, // The score is greater than or equal to the reference score
+    EngineCheck_ScoreLowerBound = 1 << 3, // The score is lower than or equal to the reference score
+    EngineCheck_All             = EngineCheck_Score | EngineCheck_Positions,
+};
+
+struct EngineEntry
+{
+    const char* Name;
+    MatchEngine Engine;
+    int         Checks;
+};
+
+static bool engine_reference(const char* pattern, const char* haystack, int& out_score, unsigned char out_matches[], int max_matches, int& out_match_count)
+{
+    return ImGui::Internal::FuzzySearchEX(pattern, haystack, out_score, out_matches, max_matches, out_match_count);
+}
+
+// Match-only prefilter: a single greedy pass finds a subsequence whenever one exists, which is all the reference needs to match
+// The reference never matches an empty pattern/haystack, nor a pattern longer than the match buffer
+static bool engine_greedy_subsequence(const char* pattern, const char* haystack, int& out_score, unsigned char[], int max_matches, int&)
+{
+    out_score = 0;
+    if (*pattern == '\0' || *haystack == '\0' || static_cast<int>(strlen(pattern)) > max_matches)
+        return false;
+    for (; *pattern != '\0' && *haystack != '\0'; ++haystack) {
+        if (tolower(*pattern) == tolower(*haystack))
+            ++pattern;
+    }
+    return *pattern == '\0';
+}
+
+// Resumable greedy matcher, with the match split in two halves to exercise the resume path
+static bool engine_greedy_resume(const char* pattern, const char* haystack, int& out_score, unsigned char[], int max_matches, int&)
+{
+    const std::string first(pattern, strlen(pattern) / 2);
+    int pos = 0;
+    out_score = 0;
+    if (first.empty())
+        return ImGui::Internal::FuzzySearchGreedy(pattern, haystack, 0, max_matches, pos, out_score);
+    return ImGui::Internal::FuzzySearchGreedy(first.c_str(), haystack, 0, max_matches, pos, out_score)
+        && ImGui::Internal::FuzzySearchGreedy(pattern + first.size(), haystack, static_cast<int>(first.size()), max_matches, pos, out_score);
+}
+
+// Phase 1 of the default filter callback
+static bool engine_score_upper_bound(const char* pattern, const char* haystack, int& out_score, unsigned char[], int max_matches, int&)
+{
+    out_score = 0;
+    return ImGui::Internal::FuzzySearchScoreUpperBound(pattern, haystack, max_matches, out_score);
+}
+
+// Score ceiling of the auto select callbacks, reported for every item the query matches
+static bool engine_score_ceiling(const char* pattern, const char* haystack, int& out_score, unsigned char[], int max_matches, int&)
+{
+    int upper_bound;
+    out_score = ImGui::Internal::FuzzySearchScoreCeiling(pattern);
+    return ImGui::Internal::FuzzySearchScoreUpperBound(pattern, haystack, max_matches, upper_bound);
+}
+
+// Register new engines here
+static const EngineEntry Engines[]{
+    { "FuzzySearchEX (determinism)", engine_reference,          EngineCheck_All },
+    { "greedy subsequence",          engine_greedy_subsequence, EngineCheck_Match },
+    { "FuzzySearchGreedy resumed",   engine_greedy_resume,      EngineCheck_ScoreLowerBound },
+    { "FuzzySearchScoreUpperBound",  engine_score_upper_bound,  EngineCheck_ScoreUpperBound },
+    { "FuzzySearchScoreCeiling",     engine_score_ceiling,      EngineCheck_ScoreUpperBound },
+};
+
+//----------------------------------------------------------------------------------------------------------------------
+// COMPARISON
+//----------------------------------------------------------------------------------------------------------------------
+
+static constexpr int MaxMatches = 128; // Same as the default search callbacks
+
+struct MatchResult
+{
+    bool          Matched;
+    int           Score;
+    int           MatchCount;
+    unsigned char Matches[256];
+};
+
+static MatchResult RunEngine(MatchEngine engine, const std::string& pattern, const std::string& haystack)
+{
+    MatchResult result;
+    result.Score = 0;
+    result.MatchCount = 0;
+    memset(result.Matches, 0, sizeof(result.Matches));
+    result.Matched = engine(pattern.c_str(), haystack.c_str(), result.Score, result.Matches, MaxMatches, result.MatchCount);
+    return result;
+}
+
+// Returns NULL if the engine agrees with the reference, or what differs
+static const char* FindDivergence(const EngineEntry& entry, const std::string& pattern, const std::string& haystack)
+{
+    const MatchResult expected = RunEngine(engine_reference, pattern, haystack);
+    const MatchResult actual = RunEngine(entry.Engine, pattern, haystack);
+    if (expected.Matched != actual.Matched)
+        return "match";
+    if (!expected.Matched)
+        return NULL;
+    if ((entry.Checks & EngineCheck_Score) && expected.Score != actual.Score)
+        return "score";
+    if ((entry.Checks & EngineCheck_ScoreUpperBound) && actual.Score < expected.Score)
+        return "score upper bound";
+    if ((entry.Checks & EngineCheck_ScoreLowerBound) && actual.Score > expected.Score)
+        return "score lower bound";
+    if ((entry.Checks & EngineCheck_Positions) && (expected.MatchCount != actual.MatchCount || memcmp(expected.Matches, actual.Matches, expected.MatchCount) != 0))
+        return "positions";
+    return NULL;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// INPUT GENERATION
+//----------------------------------------------------------------------------------------------------------------------
+
+static const char* const Separators[]{ "_", " ", "/", ".", "::", "-" };
+
+static void AppendRandomChunk(SyntheticCorpus::Random& rng, std::string& out)
+{
+    switch (rng.Range(8)) {
+    case 0:  out += SyntheticCorpus::Pick(rng, SyntheticCorpus::Utf8Fragments); break;
+    case 1:  out += SyntheticCorpus::Pick(rng, Separators); break;
+    case 2:  out += static_cast<char>('A' + rng.Range(26)); break;
+    case 3:  out += static_cast<char>(1 + rng.Range(255)); break; // Any byte but the terminator, including invalid UTF-8
+    case 4:  out += SyntheticCorpus::Pick(rng, SyntheticCorpus::Syllables); break;
+    default: out += static_cast<char>('a' + rng.Range(26)); break;
+    }
+}
+
+static std::string MakeHaystack(SyntheticCorpus::Random& rng, const std::vector<std::string>& items)
+{
+    std::string haystack;
+    switch (rng.Range(6)) {
+    case 0: // Empty
+        break;
+    case 1: // Long enough for the match positions to wrap around
+        while (haystack.size() < 255 + static_cast<size_t>(rng.Range(400)))
+            AppendRandomChunk(rng, haystack);
+        break;
+    case 2: // Random
+        for (int i = rng.Range(24); i > 0; --i)
+            AppendRandomChunk(rng, haystack);
+        break;
+    default: // Realistic items
+        haystack = items[rng.Range(static_cast<int>(items.size()))];
+        break;
+    }
+    return haystack;
+}
+
+static std::string MakePattern(SyntheticCorpus::Random& rng, const std::string& haystack)
+{
+    std::string pattern;
+    switch (rng.Range(6)) {
+    case 0: // Empty
+        break;
+    case 1: // Longer than the match buffer
+        while (static_cast<int>(pattern.size()) <= MaxMatches)
+            AppendRandomChunk(rng, pattern);
+        break;
+    case 2: // Random
+        for (int i = 1 + rng.Range(8); i > 0; --i)
+            AppendRandomChunk(rng, pattern);
+        break;
+    default: // Subsequence of the haystack, with the case of some characters flipped and sometimes a stray character
+        for (char c : haystack) {
+            if (rng.Range(4) != 0)
+                continue;
+            if (rng.Range(4) == 0 && isalpha(static_cast<unsigned char>(c)))
+                c = static_cast<char>(islower(static_cast<unsigned char>(c)) ? toupper(c) : tolower(c));
+            pattern += c;
+        }
+        if (rng.Range(4) == 0)
+            pattern.insert(pattern.begin() + rng.Range(static_cast<int>(pattern.size()) + 1), static_cast<char>('a' + rng.Range(26)));
+        break;
+    }
+    return pattern;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// MINIMIZATION
+//----------------------------------------------------------------------------------------------------------------------
+
+// Removes chunks of decreasing size from 'str' as long as the divergence remains
+template<typename PRED>
+static void MinimizeString(std::string& str, PRED&& still_diverges)
+{
+    for (size_t chunk = str.size() / 2; chunk >= 1; chunk = chunk > 1 ? chunk / 2 : 0) {
+        bool progress = true;
+        while (progress) {
+            progress = false;
+            for (size_t start = 0; start < str.size(); start += chunk) {
+                std::string candidate = str;
+                candidate.erase(start, chunk);
+                if (still_diverges(candidate)) {
+                    str = std::move(candidate);
+                    progress = true;
+                    break;
+                }
+            }
+        }
+    }
+}
+
+static void Minimize(const EngineEntry& entry, std::string& pattern, std::string& haystack)
+{
+    // Alternate between both strings, as shrinking one can make the other shrinkable again
+    for (size_t previous_size = 0; pattern.size() + haystack.size() != previous_size;) {
+        previous_size = pattern.size() + haystack.size();
+        MinimizeString(haystack, [&](const std::string& candidate) { return FindDivergence(entry, pattern, candidate) != NULL; });
+        MinimizeString(pattern, [&](const std::string& candidate) { return FindDivergence(entry, candidate, haystack) != NULL; });
+    }
+}
+
+static void PrintEscaped(const std::string& str)
+{
+    putchar('"');
+    for (unsigned char c : str) {
+        if (c == '"' || c == '\\')
+            printf("\\%c", c);
+        else if (c < 0x20 || c >= 0x7F)
+            printf("\\x%02X", c);
+        else
+            putchar(c);
+    }
+    putchar('"');
+}
+
+static void PrintResult(const char* name, const MatchResult& result)
+{
+    printf("    %-9s matched %d, score %d, positions [", name, result.Matched, result.Score);
+    for (int i = 0; i < result.MatchCount; ++i)
+        printf(i == 0 ? "%d" : " %d", result.Matches[i]);
+    printf("]\n");
+}
+
+int main(int argc, char** argv)
+{
+    const int iterations = argc > 1 ? atoi(argv[1]) : 200000;
+    const uint64_t seed = argc > 2 ? strtoull(argv[2], NULL, 10) : 1;
+    constexpr int max_reports_per_engine = 5;
+
+    std::vector<std::string> items = SyntheticCorpus::GenerateFilePaths(1000, seed);
+    for (auto&& generated : { SyntheticCorpus::GenerateSymbols(1000, seed), SyntheticCorpus::GenerateMixedUtf8(1000, seed), SyntheticCorpus::GenerateIdentifiers(1000, seed) })
+        items.insert(items.end(), generated.begin(), generated.end());
+
+    printf("%d iterations, seed %llu\n", iterations, static_cast<unsigned long long>(seed));
+
+    int failed_engines = 0;
+    for (const EngineEntry& entry : Engines) {
+        SyntheticCorpus::Random rng(seed);
+        int divergences = 0;
+        for (int i = 0; i < iterations; ++i) {
+            std::string haystack = MakeHaystack(rng, items);
+            std::string pattern = MakePattern(rng, haystack);
+            if (FindDivergence(entry, pattern, haystack) == NULL)
+                continue;
+
+            if (++divergences <= max_reports_per_engine) {
+                Minimize(entry, pattern, haystack);
+                printf("  [%s] %s divergence on iteration %d, minimized to\n    pattern  ", entry.Name, FindDivergence(entry, pattern, haystack), i);
+                PrintEscaped(pattern);
+                printf("\n    haystack ");
+                PrintEscaped(haystack);
+                printf("\n");
+                PrintResult("expected", RunEngine(engine_reference, pattern, haystack));
+                PrintResult("actual", RunEngine(entry.Engine, pattern, haystack));
+            }
+        }
+        printf("%-30s %s (%d divergences)\n", entry.Name, divergences == 0 ? "OK" : "FAILED", divergences);
+        failed_engines += divergences != 0;
+    }
+
+    return failed_engines == 0 ? 0 : 1;
+}
@@ -1,6 +1,8 @@
 #include "demo.h"
 #include "imgui-combo-filter.h"
+#include "synthetic-corpus.h"
 
+#include <chrono>
 #include <vector>
 #include <array>
 #include <span>
@@ -40,6 +42,29 @@ static const char* item_getter4(std::span<const char* const> items, int index) {
     return "";
 }
 
+struct DemoAsset
+{
+    const char* name;
+    const char* path;
+    const char* type;
+};
+
+static const char* asset_name_getter(std::span<const DemoAsset> items, int index) {
+    if (index >= 0 && index < (int)items.size()) {
+        return items[index].name;
+    }
+    return "";
+}
+
+// Detail columns are only fetched for the rows shown, a real application could look them up in its asset database here
+static const char* asset_path_getter(std::span<const DemoAsset> items, int index) {
+    return items[index].path;
+}
+
+static const char* asset_type_getter(std::span<const DemoAsset> items, int index) {
+    return items[index].type;
+}
+
 // Fuzzy search algorith by @r-lyeh with some adjustments of my own
 static bool fuzzy_score(const char* str1, const char* str2, int& score)
 {
@@ -195,8 +220,7 @@ void ShowComboAutoSelectDemo(bool* p_open)
         else if (ImGui::Button("Create ComboAutoSelect widget")) {
             create_auto_select = true;
             auto combo_data = ImGui::Internal::AddComboData<ImGui::ComboAutoSelectData>("c-array combo"); // NOTE: The hash id is dependent on the window the combo will be in, otherwise it will be unaccessible and leak would occur
-            combo_data->InitialValues.Index = 3;
-            combo_data->InitialValues.Preview = items3[3].str;
+            combo_data->SetInitialValues(items3[3].str, 3);
         }
 
         static bool remove_empty_combo = false;
@@ -253,6 +277,29 @@ void ShowComboFilterDemo(bool* p_open)
             /* Selection made */
         }
 
+        static const DemoAsset items9[]{
+            { "rock_albedo", "textures/environment/rock_albedo.png", "Texture" }, { "rock_normal", "textures/environment/rock_normal.png", "Texture" },
+            { "player_idle", "animations/player/idle.anim", "Animation" }, { "player_run", "animations/player/run.anim", "Animation" },
+            { "terrain", "materials/terrain.mat", "Material" }, { "water", "materials/water.mat", "Material" }, { "footstep_grass", "audio/footsteps/grass.wav", "Sound" },
+        };
+        static const ImGui::ComboFilterColumn<std::span<const DemoAsset>> columns9[]{
+            { "Name", asset_name_getter },
+            { "Path", asset_path_getter },
+            { "Type", asset_type_getter, 80.0f },
+            { "Score", nullptr, 40.0f },
+        };
+        static int selected_item6 = -1;
+        if (ImGui::ComboFilterTable("table popup", selected_item6, items9, asset_name_getter, columns9, IM_ARRAYSIZE(columns9))) {
+            /* Selection made */
+        }
+
+        // Two-line items, rows are as tall as their item
+        static std::vector<std::string> items8{ "imgui.cpp\nimgui/", "imgui_draw.cpp\nimgui/", "imgui-combo-filter.cpp\nimgui-combo-filter/v2/", "demo.cpp\nimgui-combo-filter/v2/", "main.cpp\nexamples/example_glfw_opengl3/", "README.md" };
+        static int selected_item5 = -1;
+        if (ImGui::ComboFilter("std::vector variable height", selected_item5, items8, item_getter1, ImGuiComboFlags_VariableHeight)) {
+            /* Selection made */
+        }
+
         ImGuiWindow* window = ImGui::GetCurrentWindow();
         const ImVec2 next_window_pos(window->Pos.x, window->Pos.y + window->Size.y + 5.0f);
         ImGui::SetNextWindowPos(next_window_pos, ImGuiCond_Always);
@@ -273,8 +320,162 @@ void ShowComboFilterDemo(bool* p_open)
                 remove_third_combofilter = false;
             }
         }
+
+        static bool show_debug_window = false;
+        ImGui::Checkbox("Show combo debug window", &show_debug_window);
+        ImGui::ShowComboDebugWindow(&show_debug_window);
     }
     ImGui::End();
 }
 
+void ShowComboFilterStressDemo(bool* p_open)
+{
+    if (p_open && !(*p_open))
+        return;
+
+    if (!ImGui::Begin("ComboFilter Stress Demo", p_open, ImGuiWindowFlags_AlwaysAutoResize)) {
+        ImGui::End();
+        return;
+    }
+
+    // Generating millions of items takes a while, so it is only done on request
+    static const char* corpus_names[]{ "Identifiers", "Words", "File paths", "C++ symbols", "Mixed UTF-8" };
+    static int corpus = 0;
+    static int item_count = 100000;
+    static std::vector<std::string> items;
+    static double generation_time = 0.0;
+    static ImGui::ComboItemSource* shared_source = nullptr; // Borrows 'items'
+    static ImGui::ComboItemSource* dafsa_source = nullptr;  // Compresses 'items' into an automaton
+    // Indexes in 'items', reset when they are generated again
+    static int selected_filter = -1;
+    static int selected_autoselect = -1;
+    static int selected_rows[16]{ -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1 };
+    static int selected_prefix = -1;
+    static int selected_substring = -1;
+    static int selected_dafsa = -1;
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 10.0f);
+    ImGui::Combo("Corpus", &corpus, corpus_names, IM_ARRAYSIZE(corpus_names));
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 10.0f);
+    ImGui::SliderInt("Item count", &item_count, 100000, 5000000, "%d", ImGuiSliderFlags_Logarithmic);
+    if (ImGui::Button("Generate") || items.empty()) {
+        const auto t0 = std::chrono::steady_clock::now();
+        switch (corpus) {
+        case 0: items = SyntheticCorpus::GenerateIdentifiers(item_count); break;
+        case 1: items = SyntheticCorpus::GenerateWords(item_count); break;
+        case 2: items = SyntheticCorpus::GenerateFilePaths(item_count); break;
+        case 3: items = SyntheticCorpus::GenerateSymbols(item_count); break;
+        default: items = SyntheticCorpus::GenerateMixedUtf8(item_count); break;
+        }
+        generation_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        // The selections and the filtered results hold indexes in the previous items
+        selected_filter = selected_autoselect = selected_prefix = selected_substring = selected_dafsa = -1;
+        for (int& selected_row : selected_rows)
+            selected_row = -1;
+        if (ImGui::Internal::GetComboData<ImGui::ComboFilterData>("large ComboFilter"))
+            ImGui::ClearComboData("large ComboFilter");
+        if (ImGui::Internal::GetComboData<ImGui::ComboAutoSelectData>("large ComboAutoSelect"))
+            ImGui::ClearComboData("large ComboAutoSelect");
+        ImGui::ClearComboItemWidthCache(&items);
+
+        // The combos picking from the shared source search again in the new items on their own
+        if (shared_source == nullptr)
+            shared_source = ImGui::RegisterComboItemSource("stress items", items, item_getter2, ImGui::ComboItemSourceStorage_Borrowed);
+        else
+            ImGui::UpdateComboItemSource(shared_source);
+        if (dafsa_source == nullptr)
+            dafsa_source = ImGui::RegisterComboItemSource("stress items (DAFSA)", items, item_getter2, ImGui::ComboItemSourceStorage_Dafsa);
+        else
+            ImGui::UpdateComboItemSource(dafsa_source, items, item_getter2);
+        // Built now rather than on the first keystroke of the prefix mode
+        ImGui::BuildComboItemSourcePrefixIndex(shared_source);
+    }
+    ImGui::SameLine();
+    ImGui::Text("%d items generated in %.2f s", static_cast<int>(items.size()), generation_time);
+
+    // Search engines, the same callback is used by both widgets. The incremental engine only exists for ComboFilter, ComboAutoSelect gets the default one
+    static const char* engine_names[]{ "Default (FuzzySearchEX)", "Demo fuzzy_score", "Incremental greedy (ComboFilter only)" };
+    static const ImGui::ComboFilterSearchCallback<std::span<const std::string>> filter_engines[]{ ImGui::Internal::DefaultComboFilterSearchCallback, filter_search, ImGui::Internal::IncrementalComboFilterSearchCallback };
+    static const ImGui::ComboAutoSelectSearchCallback<std::span<const std::string>> autoselect_engines[]{ ImGui::Internal::DefaultComboAutoSelectSearchCallback, autoselect_search, ImGui::Internal::DefaultComboAutoSelectSearchCallback };
+    static_assert(IM_ARRAYSIZE(engine_names) == IM_ARRAYSIZE(filter_engines) && IM_ARRAYSIZE(engine_names) == IM_ARRAYSIZE(autoselect_engines));
+    static int engine = 0;
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 10.0f);
+    ImGui::Combo("Search engine", &engine, engine_names, IM_ARRAYSIZE(engine_names));
+
+    static const char* height_names[]{ "Small", "Regular", "Large", "Largest" };
+    static const ImGuiComboFlags height_flags[]{ ImGuiComboFlags_HeightSmall, ImGuiComboFlags_HeightRegular, ImGuiComboFlags_HeightLarge, ImGuiComboFlags_HeightLargest };
+    static int height = 1;
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 10.0f);
+    ImGui::Combo("Popup height", &height, height_names, IM_ARRAYSIZE(height_names));
+    static bool auto_width = false;
+    ImGui::Checkbox("Auto width", &auto_width);
+    ImGui::SameLine();
+    static bool retain_draw_cache = false;
+    ImGui::Checkbox("Retain draw cache", &retain_draw_cache);
+    const ImGuiComboFlags flags = height_flags[height] | (auto_width ? ImGuiComboFlags_AutoWidth : 0) | (retain_draw_cache ? ImGuiComboFlags_RetainDrawCache : 0);
+
+    bool perf_counters = ImGui::GetComboPerfCountersEnabled();
+    if (ImGui::Checkbox("Perf counters", &perf_counters))
+        ImGui::SetComboPerfCountersEnabled(perf_counters);
+
+    ImGui::Separator();
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 20.0f);
+    ImGui::ComboFilter("large ComboFilter", selected_filter, items, item_getter2, filter_engines[engine], flags);
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 20.0f);
+    ImGui::ComboAutoSelect("large ComboAutoSelect", selected_autoselect, items, item_getter2, autoselect_engines[engine], flags);
+
+    // One combo per row picking from the same items, their search indexes and widths are built once for all of them
+    if (ImGui::TreeNode("Shared item source")) {
+        for (int row = 0; row < IM_ARRAYSIZE(selected_rows); ++row) {
+            ImGui::PushID(row);
+            ImGui::SetNextItemWidth(ImGui::GetFontSize() * 20.0f);
+            ImGui::ComboFilter("##row", selected_rows[row], shared_source, flags);
+            ImGui::PopID();
+        }
+        // Prefix mode finds the first item starting with the query with a binary search, and only runs a fuzzy search when there is none
+        static bool prefix_mode = true;
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 20.0f);
+        ImGui::ComboAutoSelect("##autoselect", selected_prefix, shared_source, prefix_mode ? ImGui::Internal::PrefixComboAutoSelectSearchCallback : ImGui::Internal::DefaultComboAutoSelectSearchCallback<const ImGui::ComboItemSource&>, flags);
+        ImGui::SameLine();
+        ImGui::Checkbox("Prefix mode", &prefix_mode);
+
+        // Substring search finds the items containing the query anywhere, with a suffix array built on the first search unless built beforehand
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 20.0f);
+        ImGui::ComboFilter("##substring", selected_substring, shared_source, ImGui::Internal::SubstringComboFilterSearchCallback, flags);
+        ImGui::SameLine();
+        if (shared_source->SuffixIndexVersion == shared_source->Version)
+            ImGui::Text("Suffix array built in %.2f s, %.1f MB", shared_source->SuffixIndexBuildTime, (shared_source->SuffixArray.Capacity + shared_source->SuffixItems.Capacity) * sizeof(int) / (1024.0 * 1024.0));
+        else if (ImGui::SmallButton("Build suffix array"))
+            ImGui::BuildComboItemSourceSuffixIndex(shared_source);
+
+        // The same items compressed into an automaton, for the prefix mode only (a fuzzy search would decode every item)
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 20.0f);
+        ImGui::ComboAutoSelect("##autoselect_dafsa", selected_dafsa, dafsa_source, ImGui::Internal::PrefixComboAutoSelectSearchCallback, flags);
+        ImGui::SameLine();
+        ImGui::Text("DAFSA %d states, %.1f MB for %.1f MB of item texts", dafsa_source->Dafsa.StateCount, dafsa_source->Dafsa.CalcMemoryUsage() / (1024.0 * 1024.0), dafsa_source->Dafsa.RawTextSize / (1024.0 * 1024.0));
+        ImGui::Text("Source version %d, %.1f KB", shared_source->Version, shared_source->CalcMemoryUsage() / 1024.0);
+        ImGui::TreePop();
+    }
+
+    // Live numbers, the filter times come from the perf counters
+    ImGui::Separator();
+    static float frame_times[120]{};
+    static int frame_time_offset = 0;
+    frame_times[frame_time_offset] = ImGui::GetIO().DeltaTime * 1000.0f;
+    frame_time_offset = (frame_time_offset + 1) % IM_ARRAYSIZE(frame_times);
+    char overlay[32];
+    ImFormatString(overlay, IM_ARRAYSIZE(overlay), "frame %.2f ms", ImGui::GetIO().DeltaTime * 1000.0f);
+    ImGui::PlotLines("##frame_times", frame_times, IM_ARRAYSIZE(frame_times), frame_time_offset, overlay, 0.0f, 50.0f, ImVec2(ImGui::GetFontSize() * 20.0f, ImGui::GetFontSize() * 3.0f));
+
+    if (const ImGui::ComboFilterData* combo_data = ImGui::Internal::GetComboData<ImGui::ComboFilterData>("large ComboFilter"))
+        ImGui::Text("ComboFilter results: %d", combo_data->FilterStatus ? static_cast<int>(combo_data->FilteredItems.size()) : static_cast<int>(items.size()));
+    if (const ImGui::ComboPerfCounters* counters = ImGui::GetComboPerfCounters("large ComboFilter"))
+        ImGui::Text("ComboFilter last filter %.2f ms, last sort %.2f ms, worst latency %.2f ms", counters->LastFilterTime * 1e3, counters->LastSortTime * 1e3, counters->LatencyMax * 1e3);
+    ImGui::Text("ComboAutoSelect selection: %d", selected_autoselect);
+    if (const ImGui::ComboPerfCounters* counters = ImGui::GetComboPerfCounters("large ComboAutoSelect"))
+        ImGui::Text("ComboAutoSelect last search %.2f ms, worst latency %.2f ms", counters->LastFilterTime * 1e3, counters->LatencyMax * 1e3);
+
+    ImGui::End();
+}
+
 }
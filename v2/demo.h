@@ -5,5 +5,6 @@ namespace ImGui
 
 void ShowComboAutoSelectDemo(bool* p_open = nullptr);
 void ShowComboFilterDemo(bool* p_open = nullptr);
+void ShowComboFilterStressDemo(bool* p_open = nullptr); // Generates up to millions of items to check how the widgets and search callbacks scale
 
 }
\ No newline at end of file
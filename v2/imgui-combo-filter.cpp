@@ -3,13 +3,18 @@
 #include <ctype.h>        // tolower()
 #include <memory>         // std::unique_ptr
 #include <unordered_map>  // std::unordered_map
-#include <algorithm>      // std::sort
+#include <algorithm>      // std::sort, std::upper_bound
+#include <chrono>         // std::chrono::steady_clock
+#include <list>           // std::list
+#include <limits.h>       // INT_MIN
 
 // Macro helper for creating/adding specialization for a combo data
 #define CREATECOMBODATA_FUNCTIONS_SPECIALIZATION(T)    \
 template T* AddComboData<T>(const char*, const char*); \
 template T* AddComboData<T>(const char*);              \
 template T* AddComboData<T>(ImGuiID);                  \
+template T* AddComboData<T>(ImGuiWindow*, ImGuiID);    \
+template T* FindComboData<T>(ImGuiWindow*, ImGuiID);   \
 template T* GetComboData<T>(const char*, const char*); \
 template T* GetComboData<T>(const char*);              \
 template T* GetComboData<T>(ImGuiID)
@@ -29,6 +34,147 @@ struct ComboMapHasher
 };
 
 static std::unordered_map<ImGuiID, std::unique_ptr<ComboData>, ComboMapHasher> gComboHashMap{ }; // Internal storage for combo datas
+static int gUnslottedComboDataCount = 0; // Combo datas added by id only, which the widgets have to look up in gComboHashMap once
+static std::unordered_map<const void*, ComboItemWidthCache> gComboItemWidthCaches{ }; // Keyed by container address, for ImGuiComboFlags_AutoWidth
+static std::unordered_map<ImGuiID, std::unique_ptr<ComboItemSource>, ComboMapHasher> gComboItemSources{ };
+
+// Filter results shared by the combos listing the same ComboItemSource, most recently used first
+struct ComboResultCacheEntry
+{
+    ImGuiID                  Key;
+    const void*              ItemsSource;
+    int                      ItemsVersion;
+    ImGuiID                  EngineID;
+    ImVector<char>           Query;
+    ComboFilterSearchResults Results;
+    ComboFilterRanking       Ranking;
+
+    size_t CalcMemoryUsage() const { return sizeof(*this) + Query.Capacity + Results.capacity() * sizeof(ComboFilterSearchResultData); }
+};
+using ComboResultCacheList = std::list<ComboResultCacheEntry>;
+static ComboResultCacheList gComboResultCache{ };
+static std::unordered_map<ImGuiID, ComboResultCacheList::iterator, ComboMapHasher> gComboResultCacheLookup{ }; // Keyed by CalcComboResultCacheKey()
+static size_t gComboResultCacheBytes = 0;
+static size_t gComboResultCacheBudget = 16 << 20;
+static void EraseComboCachedResults(ComboResultCacheList::iterator it);
+
+// Greedy matches kept by IncrementalComboFilterSearchCallback for the next keystroke
+struct ComboResumeState
+{
+    ImGuiID                    Key;
+    int                        LastUsed;
+    ImVector<ComboResumeMatch> Matches;
+
+    size_t CalcMemoryUsage() const { return sizeof(*this) + Matches.Capacity * sizeof(ComboResumeMatch); }
+};
+static std::vector<ComboResumeState> gComboResumeStates{ };
+static size_t gComboResumeStateBytes = 0;
+static int gComboResumeStateClock = 0;
+
+static bool gComboPerfCountersEnabled = false;
+static std::unordered_map<ImGuiID, ComboPerfCounters, ComboMapHasher> gComboPerfCounters{ }; // Kept separately so they survive ClearComboData
+static ComboPerfCounters* gCurrentComboPerfCounters = nullptr;                              // Counters of the search in progress, for the sort timings
+
+static double GetComboPerfTime()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct ComboTraceHooks
+{
+    ComboTraceHookCallback Begin    = nullptr;
+    ComboTraceHookCallback End      = nullptr;
+    void*                  UserData = nullptr;
+};
+
+static ComboTraceHooks gComboTraceHooks{ };
+[[maybe_unused]] static ImGuiID gComboTraceSearchID = 0; // Combo being searched, reported with the sort events (unused when tracing is compiled out)
+
+struct ComboSessionRecorder
+{
+    ImGuiID                 ComboID = 0;   // 0 when not recording
+    ImVector<char>          Filename;
+    ImVector<unsigned char> Buffer;
+    double                  LastEventTime = 0.0;
+};
+
+static ComboSessionRecorder gComboSessionRecorder{ };
+static constexpr char ComboSessionMagic[4]{ 'I', 'C', 'S', 'R' };
+static constexpr unsigned char ComboSessionVersion = 1;
+
+static void WriteComboSessionVarint(ImVector<unsigned char>& buf, unsigned long long value)
+{
+    for (; value >= 0x80; value >>= 7)
+        buf.push_back(static_cast<unsigned char>(value | 0x80));
+    buf.push_back(static_cast<unsigned char>(value));
+}
+
+static bool ReadComboSessionVarint(const unsigned char*& p, const unsigned char* end, unsigned long long& out_value)
+{
+    out_value = 0;
+    for (int shift = 0; p < end && shift < 64; shift += 7) {
+        const unsigned char byte = *p++;
+        out_value |= static_cast<unsigned long long>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return true;
+    }
+    return false;
+}
+
+// Accounts the lifetime of the scope to the sort time of the search in progress, if any
+#ifndef IMGUI_COMBO_FILTER_DISABLE_PERF_COUNTERS
+struct ComboPerfSortScope
+{
+    ComboPerfCounters* Counters;
+    double             StartTime;
+
+    ComboPerfSortScope() : Counters(gCurrentComboPerfCounters), StartTime(Counters ? GetComboPerfTime() : 0.0) {}
+    ~ComboPerfSortScope()
+    {
+        if (Counters)
+            Counters->SortTimeInSearch += GetComboPerfTime() - StartTime;
+    }
+};
+
+#define IMGUI_COMBO_PERF_SORT_SCOPE() ImGui::Internal::ComboPerfSortScope combo_perf_sort_scope
+#else
+#define IMGUI_COMBO_PERF_SORT_SCOPE() ((void)0)
+#endif
+
+// Every combo data created for a window is also referenced in the state storage of that window,
+// so the widgets find it with a lookup in a small sorted array instead of the global hash map
+static ImGuiID GetComboDataSlotKey(ImGuiID combo_id)
+{
+    return ImHashStr("ComboData", 0, combo_id);
+}
+
+static void SetComboDataSlot(ImGuiWindow* window, ImGuiID combo_id, ComboData* combo_data)
+{
+    if (combo_data->OwnerWindowID == 0 && window != NULL)
+        --gUnslottedComboDataCount;
+    combo_data->OwnerWindowID = window->ID;
+    window->StateStorage.SetVoidPtr(GetComboDataSlotKey(combo_id), combo_data);
+}
+
+// NULL if the window is gone (e.g. destroyed with its context), or is a new window with the same ID that does not reference the combo data
+static ImGuiWindow* FindComboDataOwnerWindow(ImGuiID combo_id, const ComboData* combo_data)
+{
+    if (combo_data->OwnerWindowID == 0 || GImGui == NULL)
+        return NULL;
+    ImGuiWindow* window = ImGui::FindWindowByID(combo_data->OwnerWindowID);
+    if (window == NULL || window->StateStorage.GetVoidPtr(GetComboDataSlotKey(combo_id)) != combo_data)
+        return NULL;
+    return window;
+}
+
+static void EraseComboData(std::unordered_map<ImGuiID, std::unique_ptr<ComboData>, ComboMapHasher>::iterator it)
+{
+    if (it->second->OwnerWindowID == 0)
+        --gUnslottedComboDataCount;
+    else if (ImGuiWindow* window = FindComboDataOwnerWindow(it->first, it->second.get()))
+        window->StateStorage.SetVoidPtr(GetComboDataSlotKey(it->first), NULL);
+    gComboHashMap.erase(it);
+}
 
 template<class T>
 T* AddComboData(const char* window_label, const char* combo_label)
@@ -36,7 +182,7 @@ T* AddComboData(const char* window_label, const char* combo_label)
     ImGuiWindow* window = ImGui::FindWindowByName(window_label);
     IM_ASSERT(window && "Queried window does not exist!");
     ImGuiID id = window->GetID(combo_label);
-    return AddComboData<T>(id);
+    return AddComboData<T>(window, id);
 }
 
 template<class T>
@@ -44,7 +190,7 @@ T* AddComboData(const char* combo_label)
 {
     ImGuiWindow* window = ImGui::GetCurrentWindow();
     ImGuiID id = window->GetID(combo_label);
-    return AddComboData<T>(id);
+    return AddComboData<T>(window, id);
 }
 
 template<class T>
@@ -53,9 +199,38 @@ T* AddComboData(ImGuiID combo_id)
     IM_ASSERT(!Internal::gComboHashMap.contains(combo_id) && "A combo data currently exists on the same id!");
     auto& new_data = Internal::gComboHashMap[combo_id];
     new_data.reset(new T());
+    ++gUnslottedComboDataCount;
     return static_cast<T*>(new_data.get());
 }
 
+template<class T>
+T* AddComboData(ImGuiWindow* window, ImGuiID combo_id)
+{
+    // A combo data whose window was destroyed (with its context) is not found through the new window, it is replaced
+    auto it = Internal::gComboHashMap.find(combo_id);
+    if (it != Internal::gComboHashMap.end() && it->second->OwnerWindowID != 0 && FindComboDataOwnerWindow(combo_id, it->second.get()) == NULL)
+        EraseComboData(it);
+    T* combo_data = AddComboData<T>(combo_id);
+    SetComboDataSlot(window, combo_id, combo_data);
+    return combo_data;
+}
+
+template<class T>
+T* FindComboData(ImGuiWindow* window, ImGuiID combo_id)
+{
+    if (void* combo_data = window->StateStorage.GetVoidPtr(GetComboDataSlotKey(combo_id))) {
+        IM_ASSERT(dynamic_cast<T*>(static_cast<ComboData*>(combo_data)) && "Incorrect ComboData type!");
+        return static_cast<T*>(static_cast<ComboData*>(combo_data));
+    }
+    if (gUnslottedComboDataCount == 0)
+        return nullptr;
+
+    T* combo_data = GetComboData<T>(combo_id);
+    if (combo_data)
+        SetComboDataSlot(window, combo_id, combo_data);
+    return combo_data;
+}
+
 template<class T>
 T* GetComboData(const char* window_label, const char* combo_label)
 {
@@ -103,8 +278,248 @@ void ClearComboData(const char* combo_label)
 
 void ClearComboData(ImGuiID combo_id)
 {
-    IM_ASSERT(Internal::gComboHashMap.contains(combo_id) && "There is no existing combo data on the id you are trying to erase!");
-    Internal::gComboHashMap.erase(combo_id);
+    auto it = Internal::gComboHashMap.find(combo_id);
+    IM_ASSERT(it != Internal::gComboHashMap.end() && "There is no existing combo data on the id you are trying to erase!");
+    Internal::EraseComboData(it);
+}
+
+int ClearIdleComboData(int max_idle_frames)
+{
+    IM_ASSERT(max_idle_frames >= 0);
+    const int frame_count = GImGui->FrameCount;
+    int cleared_count = 0;
+    for (auto it = Internal::gComboHashMap.begin(); it != Internal::gComboHashMap.end();) {
+        auto next = std::next(it);
+        if (frame_count - it->second->LastUsedFrame > max_idle_frames) {
+            Internal::EraseComboData(it);
+            ++cleared_count;
+        }
+        it = next;
+    }
+    // Width caches are not counted, they are cheap to rebuild and only hold measurements
+    std::erase_if(Internal::gComboItemWidthCaches, [&](const auto& entry) { return frame_count - entry.second.LastUsedFrame > max_idle_frames; });
+    return cleared_count;
+}
+
+void ClearComboItemWidthCache(const void* items_source)
+{
+    if (items_source == NULL)
+        Internal::gComboItemWidthCaches.clear();
+    else
+        Internal::gComboItemWidthCaches.erase(items_source);
+}
+
+void ClearComboItemCaches(ImGuiID combo_id)
+{
+    auto it = Internal::gComboHashMap.find(combo_id);
+    if (it == Internal::gComboHashMap.end())
+        return;
+    it->second->DrawCache.Valid = false;
+    if (ComboFilterData* filter_data = dynamic_cast<ComboFilterData*>(it->second.get())) {
+        filter_data->ColumnTexts.Clear();
+        filter_data->History.Clear();
+        filter_data->ItemsVersion = -1; // An open popup searches the query again, as for a new items version
+    }
+}
+
+void SetComboResultCacheBudget(size_t max_bytes)
+{
+    Internal::gComboResultCacheBudget = max_bytes;
+    while (Internal::gComboResultCacheBytes > max_bytes)
+        Internal::EraseComboCachedResults(std::prev(Internal::gComboResultCache.end()));
+}
+
+size_t GetComboResultCacheBudget()
+{
+    return Internal::gComboResultCacheBudget;
+}
+
+void ClearComboResultCache(const void* items_source)
+{
+    for (auto it = Internal::gComboResultCache.begin(); it != Internal::gComboResultCache.end();) {
+        auto next = std::next(it);
+        if (items_source == NULL || it->ItemsSource == items_source)
+            Internal::EraseComboCachedResults(it);
+        it = next;
+    }
+}
+
+void UpdateComboItemSource(ComboItemSource* source)
+{
+    IM_ASSERT(source != NULL);
+    IM_ASSERT(source->Storage == ComboItemSourceStorage_Borrowed && "Owned items are copies, update the source with the new items instead");
+    Internal::OnComboItemSourceChanged(*source);
+}
+
+void BuildComboItemSourcePrefixIndex(const ComboItemSource* source)
+{
+    IM_ASSERT(source != NULL);
+    if (source->Storage != ComboItemSourceStorage_Dafsa)
+        source->BuildPrefixIndex();
+}
+
+void BuildComboItemSourceSuffixIndex(const ComboItemSource* source)
+{
+    IM_ASSERT(source != NULL);
+    if (source->Storage != ComboItemSourceStorage_Dafsa)
+        source->BuildSuffixIndex();
+}
+
+void UnregisterComboItemSource(ComboItemSource* source)
+{
+    IM_ASSERT(source != NULL);
+    ClearComboItemWidthCache(source);
+    ClearComboResultCache(source);
+    auto it = Internal::gComboItemSources.find(source->ID);
+    IM_ASSERT(it != Internal::gComboItemSources.end() && it->second.get() == source && "The item source is not registered!");
+    Internal::gComboItemSources.erase(it);
+}
+
+ComboItemSource* FindComboItemSource(const char* name)
+{
+    return FindComboItemSource(ImHashStr(name));
+}
+
+ComboItemSource* FindComboItemSource(ImGuiID source_id)
+{
+    auto it = Internal::gComboItemSources.find(source_id);
+    return it != Internal::gComboItemSources.end() ? it->second.get() : NULL;
+}
+
+const char* GetComboItemSourceItem(const ComboItemSource& source, int index)
+{
+    return source.GetItem(index);
+}
+
+bool ComboAutoSelect(const char* combo_label, int& selected_item, const ComboItemSource* source, ComboAutoSelectSearchCallback<const ComboItemSource&> autoselect_callback, ImGuiComboFlags flags)
+{
+    IM_ASSERT(source != NULL);
+    return ComboAutoSelect(combo_label, selected_item, *source, GetComboItemSourceItem, autoselect_callback, flags);
+}
+
+bool ComboAutoSelect(const char* combo_label, int& selected_item, const ComboItemSource* source, ImGuiComboFlags flags)
+{
+    return ComboAutoSelect(combo_label, selected_item, source, Internal::DefaultComboAutoSelectSearchCallback<const ComboItemSource&>, flags);
+}
+
+bool ComboFilter(const char* combo_label, int& selected_item, const ComboItemSource* source, ComboFilterSearchCallback<const ComboItemSource&> filter_callback, ImGuiComboFlags flags)
+{
+    IM_ASSERT(source != NULL);
+    return ComboFilter(combo_label, selected_item, *source, GetComboItemSourceItem, filter_callback, flags);
+}
+
+bool ComboFilter(const char* combo_label, int& selected_item, const ComboItemSource* source, ImGuiComboFlags flags)
+{
+    return ComboFilter(combo_label, selected_item, source, Internal::DefaultComboFilterSearchCallback<const ComboItemSource&>, flags);
+}
+
+void ShowComboDebugWindow(bool* p_open)
+{
+    if (p_open && !(*p_open))
+        return;
+
+    if (!ImGui::Begin("Combo Debug", p_open)) {
+        ImGui::End();
+        return;
+    }
+
+    const int frame_count = GImGui->FrameCount;
+    using ComboEntry = std::pair<ImGuiID, const Internal::ComboData*>;
+    ImVector<ComboEntry> entries;
+    entries.reserve(static_cast<int>(Internal::gComboHashMap.size()));
+    size_t total_bytes = 0;
+    size_t total_cached_indexes = 0;
+    for (const auto& [id, data] : Internal::gComboHashMap) {
+        entries.push_back({ id, data.get() });
+        total_bytes += data->CalcMemoryUsage();
+        if (const ComboFilterData* filter_data = dynamic_cast<const ComboFilterData*>(data.get()))
+            total_cached_indexes += filter_data->FilteredItems.size();
+    }
+    // Most idle first, those are the ones likely to be leaked
+    std::sort(entries.begin(), entries.end(), [](const ComboEntry& a, const ComboEntry& b) { return a.second->LastUsedFrame < b.second->LastUsedFrame; });
+
+    // Node and bucket overhead of the storage itself, approximated as one value and one pointer per node
+    using ComboMap = decltype(Internal::gComboHashMap);
+    const size_t storage_bytes = Internal::gComboHashMap.bucket_count() * sizeof(void*) + Internal::gComboHashMap.size() * (sizeof(ComboMap::value_type) + sizeof(void*));
+
+    ImGui::Text("Combo datas: %d, owned: %.1f KB, storage overhead: ~%.1f KB", entries.Size, total_bytes / 1024.0, storage_bytes / 1024.0);
+    ImGui::Text("Cached indexes: %zu", total_cached_indexes);
+    size_t width_cache_bytes = 0;
+    for (const auto& [source, cache] : Internal::gComboItemWidthCaches)
+        width_cache_bytes += sizeof(cache) + cache.Widths.Capacity * sizeof(float);
+    ImGui::Text("Item width caches: %d, %.1f KB", static_cast<int>(Internal::gComboItemWidthCaches.size()), width_cache_bytes / 1024.0);
+    size_t item_source_bytes = 0;
+    for (const auto& [id, source] : Internal::gComboItemSources)
+        item_source_bytes += source->CalcMemoryUsage();
+    ImGui::Text("Item sources: %d, %.1f KB", static_cast<int>(Internal::gComboItemSources.size()), item_source_bytes / 1024.0);
+    ImGui::Text("Result cache: %d queries, %.1f / %.1f KB", static_cast<int>(Internal::gComboResultCache.size()), Internal::gComboResultCacheBytes / 1024.0, Internal::gComboResultCacheBudget / 1024.0);
+    ImGui::Text("Resume states: %d, %.1f KB", static_cast<int>(Internal::gComboResumeStates.size()), Internal::gComboResumeStateBytes / 1024.0);
+
+    static int max_idle_frames = 600;
+    ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8.0f);
+    ImGui::InputInt("Max idle frames", &max_idle_frames);
+    max_idle_frames = ImMax(max_idle_frames, 0);
+    ImGui::SameLine();
+    static int last_cleared_count = -1;
+    if (ImGui::Button("Clear idle"))
+        last_cleared_count = ClearIdleComboData(max_idle_frames);
+    if (last_cleared_count >= 0) {
+        ImGui::SameLine();
+        ImGui::Text("Cleared %d", last_cleared_count);
+    }
+
+    ImGuiID clear_id = 0;
+    constexpr ImGuiTableFlags table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingFixedFit;
+    if (ImGui::BeginTable("##combo_datas", 9, table_flags)) {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("ID");
+        ImGui::TableSetupColumn("Window");
+        ImGui::TableSetupColumn("Type");
+        ImGui::TableSetupColumn("Input", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Last used");
+        ImGui::TableSetupColumn("Cached indexes");
+        ImGui::TableSetupColumn("Capacity");
+        ImGui::TableSetupColumn("Bytes");
+        ImGui::TableSetupColumn("");
+        ImGui::TableHeadersRow();
+
+        ImGuiListClipper clipper;
+        clipper.Begin(entries.Size);
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i) {
+                const auto& [id, data] = entries[i];
+                const ComboFilterData* filter_data = dynamic_cast<const ComboFilterData*>(data);
+                ImGui::PushID(static_cast<int>(id));
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn(); ImGui::Text("0x%08X", id);
+                ImGui::TableNextColumn(); const ImGuiWindow* owner_window = Internal::FindComboDataOwnerWindow(id, data);
+                ImGui::TextUnformatted(owner_window ? owner_window->Name : "-");
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(filter_data ? "ComboFilter" : "ComboAutoSelect");
+                ImGui::TableNextColumn(); ImGui::TextUnformatted(data->InputText);
+                ImGui::TableNextColumn(); ImGui::Text("%d (%d ago)", data->LastUsedFrame, frame_count - data->LastUsedFrame);
+                if (filter_data) {
+                    ImGui::TableNextColumn(); ImGui::Text("%zu", filter_data->FilteredItems.size());
+                    ImGui::TableNextColumn(); ImGui::Text("%zu", filter_data->FilteredItems.capacity());
+                }
+                else {
+                    ImGui::TableNextColumn(); ImGui::TextDisabled("-");
+                    ImGui::TableNextColumn(); ImGui::TextDisabled("-");
+                }
+                ImGui::TableNextColumn(); ImGui::Text("%zu", data->CalcMemoryUsage());
+                ImGui::TableNextColumn();
+                if (ImGui::SmallButton("Clear"))
+                    clear_id = id;
+                ImGui::PopID();
+            }
+        }
+        ImGui::EndTable();
+    }
+
+    // Cleared after listing so the entries stay valid while drawing
+    if (clear_id != 0)
+        ClearComboData(clear_id);
+
+    ImGui::End();
 }
 
 bool ComboAutoSelectData::SetNewValue(const char* new_val, int new_index) noexcept
@@ -118,15 +533,14 @@ bool ComboAutoSelectData::SetNewValue(const char* new_val) noexcept
     bool ret;
     if (ret = CurrentSelection != InitialValues.Index) {
         strncpy(InputText, new_val, StringCapacity);
-        InitialValues.Preview = new_val;
-        InitialValues.Index = CurrentSelection;
+        SetInitialValues(new_val, CurrentSelection);
     }
     return ret;
 }
 
 void ComboAutoSelectData::ResetToInitialValue() noexcept
 {
-    strncpy(InputText, InitialValues.Preview, StringCapacity);
+    strncpy(InputText, GetInitialPreview(), StringCapacity);
     CurrentSelection = InitialValues.Index;
 }
 
@@ -134,8 +548,7 @@ void ComboAutoSelectData::Reset() noexcept
 {
     InputText[0] = '\0';
     CurrentSelection = -1;
-    InitialValues.Index = -1;
-    InitialValues.Preview = "";
+    SetInitialValues("", -1);
 }
 
 bool ComboFilterData::SetNewValue(const char* new_val, int new_index) noexcept
@@ -152,13 +565,13 @@ bool ComboFilterData::SetNewValue(const char* new_val) noexcept
         FilteredItems.clear();
         FilterStatus = false;
         InputText[0] = '\0';
+        RowHeights.Invalidate();
+        History.Clear();
     }
 
     bool ret;
-    if (ret = CurrentSelection != InitialValues.Index) {
-        InitialValues.Preview = new_val;
-        InitialValues.Index = CurrentSelection;
-    }
+    if (ret = CurrentSelection != InitialValues.Index)
+        SetInitialValues(new_val, CurrentSelection);
     return ret;
 }
 
@@ -167,27 +580,267 @@ void ComboFilterData::ResetToInitialValue() noexcept
     FilterStatus = false;
     InputText[0] = '\0';
     FilteredItems.clear();
+    RowHeights.Invalidate();
+    History.Clear();
     CurrentSelection = InitialValues.Index;
 }
 
+size_t ComboFilterData::CalcMemoryUsage() const noexcept
+{
+    return ComboData::CalcMemoryUsage() - sizeof(ComboData) + sizeof(*this) + FilteredItems.capacity() * sizeof(ComboFilterSearchResultData) + ColumnTexts.CalcMemoryUsage() - sizeof(ColumnTexts) + History.CalcMemoryUsage() - sizeof(History);
+}
+
 void ComboFilterData::ResetAll() noexcept
 {
     FilteredItems.clear();
+    RowHeights.Invalidate();
+    History.Clear();
     InputText[0] = '\0';
     CurrentSelection = -1;
-    InitialValues.Index = -1;
-    InitialValues.Preview = "";
+    SetInitialValues("", -1);
     FilterStatus = false;
 }
 
 void SortFilterResultsDescending(ComboFilterSearchResults& filtered_items)
 {
-    std::sort(filtered_items.rbegin(), filtered_items.rend());
+    IMGUI_COMBO_TRACE_SCOPE(ComboTracePhase_Sort, Internal::gComboTraceSearchID);
+    IMGUI_COMBO_PERF_SORT_SCOPE();
+    Internal::SortFilterResultsStable(filtered_items, true);
 }
 
 void SortFilterResultsAscending(ComboFilterSearchResults& filtered_items)
 {
-    std::sort(filtered_items.begin(), filtered_items.end());
+    IMGUI_COMBO_TRACE_SCOPE(ComboTracePhase_Sort, Internal::gComboTraceSearchID);
+    IMGUI_COMBO_PERF_SORT_SCOPE();
+    Internal::SortFilterResultsStable(filtered_items, false);
+}
+
+void SetComboTraceHooks(ComboTraceHookCallback begin_hook, ComboTraceHookCallback end_hook, void* user_data)
+{
+    Internal::gComboTraceHooks.Begin = begin_hook;
+    Internal::gComboTraceHooks.End = end_hook;
+    Internal::gComboTraceHooks.UserData = user_data;
+}
+
+const char* GetComboTracePhaseName(ComboTracePhase phase)
+{
+    static const char* const names[]{ "ComboPopupSetup", "ComboSearch", "ComboSort", "ComboClipper" };
+    static_assert(IM_ARRAYSIZE(names) == ComboTracePhase_COUNT);
+    IM_ASSERT(phase >= 0 && phase < ComboTracePhase_COUNT);
+    return names[phase];
+}
+
+bool StartComboSessionRecording(const char* window_label, const char* combo_label, const char* filename)
+{
+    ImGuiWindow* window = ImGui::FindWindowByName(window_label);
+    IM_ASSERT(window && "Queried window does not exist!");
+    ImGuiID id = window->GetID(combo_label);
+    return StartComboSessionRecording(id, filename);
+}
+
+bool StartComboSessionRecording(const char* combo_label, const char* filename)
+{
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    ImGuiID id = window->GetID(combo_label);
+    return StartComboSessionRecording(id, filename);
+}
+
+bool StartComboSessionRecording(ImGuiID combo_id, const char* filename)
+{
+    IM_ASSERT(combo_id != 0 && filename != NULL);
+    Internal::ComboSessionRecorder& recorder = Internal::gComboSessionRecorder;
+    if (recorder.ComboID != 0)
+        return false;
+
+    recorder.ComboID = combo_id;
+    recorder.Filename.resize(static_cast<int>(strlen(filename)) + 1);
+    memcpy(recorder.Filename.Data, filename, recorder.Filename.Size);
+    recorder.Buffer.resize(0);
+    recorder.Buffer.reserve(4096);
+    for (char c : Internal::ComboSessionMagic)
+        recorder.Buffer.push_back(static_cast<unsigned char>(c));
+    recorder.Buffer.push_back(Internal::ComboSessionVersion);
+    recorder.LastEventTime = Internal::GetComboPerfTime();
+    return true;
+}
+
+bool StopComboSessionRecording()
+{
+    Internal::ComboSessionRecorder& recorder = Internal::gComboSessionRecorder;
+    if (recorder.ComboID == 0)
+        return false;
+    recorder.ComboID = 0;
+
+    // The buffer is dropped even if the file cannot be written, a failed recording is not kept in memory
+    ImFileHandle file = ImFileOpen(recorder.Filename.Data, "wb");
+    const ImU64 size = static_cast<ImU64>(recorder.Buffer.Size);
+    const bool written = file && ImFileWrite(recorder.Buffer.Data, 1, size, file) == size;
+    if (file)
+        ImFileClose(file);
+    recorder.Buffer.clear();
+    return written;
+}
+
+bool IsComboSessionRecording()
+{
+    return Internal::gComboSessionRecorder.ComboID != 0;
+}
+
+bool LoadComboSession(const char* filename, ComboSession& out_session)
+{
+    out_session.Events.resize(0);
+    out_session.Queries.resize(0);
+
+    size_t file_size = 0;
+    unsigned char* file_data = static_cast<unsigned char*>(ImFileLoadToMemory(filename, "rb", &file_size));
+    if (!file_data)
+        return false;
+
+    const unsigned char* p = file_data;
+    const unsigned char* end = file_data + file_size;
+    bool valid = file_size > sizeof(Internal::ComboSessionMagic) && memcmp(p, Internal::ComboSessionMagic, sizeof(Internal::ComboSessionMagic)) == 0 && p[sizeof(Internal::ComboSessionMagic)] == Internal::ComboSessionVersion;
+    p += sizeof(Internal::ComboSessionMagic) + 1;
+
+    double time = 0.0;
+    while (valid && p < end) {
+        unsigned long long delta_us, value;
+        valid = Internal::ReadComboSessionVarint(p, end, delta_us) && p < end && *p < ComboSessionEvent_COUNT;
+        if (!valid)
+            break;
+
+        time += static_cast<double>(delta_us) * 1e-6;
+        ComboSessionEvent e{ static_cast<ComboSessionEventType>(*p++), time, { 0, 0, 0 }, 0, 0 };
+        switch (e.Type) {
+        case ComboSessionEvent_Open:
+            for (int i = 0; valid && i < 3; ++i) {
+                valid = Internal::ReadComboSessionVarint(p, end, value);
+                e.Value[i] = static_cast<int>(value);
+            }
+            break;
+        case ComboSessionEvent_Select:
+            valid = Internal::ReadComboSessionVarint(p, end, value);
+            e.Value[0] = static_cast<int>(value);
+            break;
+        case ComboSessionEvent_Query:
+            valid = Internal::ReadComboSessionVarint(p, end, value) && value <= static_cast<unsigned long long>(end - p);
+            if (valid) {
+                e.QueryOffset = out_session.Queries.Size;
+                e.QueryLength = static_cast<int>(value);
+                out_session.Queries.resize(e.QueryOffset + e.QueryLength + 1);
+                memcpy(out_session.Queries.Data + e.QueryOffset, p, e.QueryLength);
+                out_session.Queries[e.QueryOffset + e.QueryLength] = '\0';
+                p += e.QueryLength;
+            }
+            break;
+        default:
+            break;
+        }
+        if (valid)
+            out_session.Events.push_back(e);
+    }
+
+    IM_FREE(file_data);
+    return valid;
+}
+
+const char* GetComboSessionEventName(ComboSessionEventType type)
+{
+    static const char* const names[]{ "Open", "Close", "Query", "Up", "Down", "Enter", "Escape", "Select" };
+    static_assert(IM_ARRAYSIZE(names) == ComboSessionEvent_COUNT);
+    IM_ASSERT(type >= 0 && type < ComboSessionEvent_COUNT);
+    return names[type];
+}
+
+void SetComboPerfCountersEnabled(bool enabled)
+{
+    Internal::gComboPerfCountersEnabled = enabled;
+}
+
+bool GetComboPerfCountersEnabled()
+{
+    return Internal::gComboPerfCountersEnabled;
+}
+
+const ComboPerfCounters* GetComboPerfCounters(const char* window_label, const char* combo_label)
+{
+    ImGuiWindow* window = ImGui::FindWindowByName(window_label);
+    IM_ASSERT(window && "Queried window does not exist!");
+    ImGuiID id = window->GetID(combo_label);
+    return GetComboPerfCounters(id);
+}
+
+const ComboPerfCounters* GetComboPerfCounters(const char* combo_label)
+{
+    ImGuiWindow* window = ImGui::GetCurrentWindow();
+    ImGuiID id = window->GetID(combo_label);
+    return GetComboPerfCounters(id);
+}
+
+const ComboPerfCounters* GetComboPerfCounters(ImGuiID combo_id)
+{
+    auto it = Internal::gComboPerfCounters.find(combo_id);
+    return it == Internal::gComboPerfCounters.end() ? nullptr : &it->second;
+}
+
+void ResetComboPerfCounters()
+{
+    IM_ASSERT(Internal::gCurrentComboPerfCounters == nullptr && "Can't reset the counters during a search!");
+    Internal::gComboPerfCounters.clear();
+}
+
+void ExportComboPerfCountersJSON(ImGuiTextBuffer& out_buf)
+{
+    out_buf.append("[\n");
+    bool first = true;
+    for (const auto& [id, counters] : Internal::gComboPerfCounters) {
+        // Labels are user strings, escape what JSON does not allow in a string
+        char label[IM_ARRAYSIZE(counters.Label) * 6];
+        char* out = label;
+        for (const char* c = counters.Label; *c != '\0'; ++c) {
+            if (*c == '"' || *c == '\\')
+                out += ImFormatString(out, label + sizeof(label) - out, "\\%c", *c);
+            else if (static_cast<unsigned char>(*c) < 0x20)
+                out += ImFormatString(out, label + sizeof(label) - out, "\\u%04x", *c);
+            else
+                *out++ = *c;
+        }
+        *out = '\0';
+
+        out_buf.appendf("%s  {\"id\": %u, \"label\": \"%s\", \"searches\": %d, \"items_scanned\": %lld, \"candidates_rejected\": %lld, \"matches_produced\": %lld, ",
+            first ? "" : ",\n", id, label, counters.SearchCount, counters.ItemsScanned, counters.CandidatesRejected, counters.MatchesProduced);
+        out_buf.appendf("\"filter_time_ms\": %.4f, \"sort_time_ms\": %.4f, \"last_filter_time_ms\": %.4f, \"last_sort_time_ms\": %.4f, \"latency_max_ms\": %.4f, \"latency_histogram_us\": [",
+            counters.FilterTime * 1e3, counters.SortTime * 1e3, counters.LastFilterTime * 1e3, counters.LastSortTime * 1e3, counters.LatencyMax * 1e3);
+        for (int i = 0; i < ComboPerfCounters::LatencyBucketCount; ++i)
+            out_buf.appendf(i == 0 ? "%d" : ", %d", counters.LatencyHistogram[i]);
+        out_buf.append("]}");
+        first = false;
+    }
+    out_buf.append(first ? "]\n" : "\n]\n");
+}
+
+void ExportComboPerfCountersCSV(ImGuiTextBuffer& out_buf)
+{
+    out_buf.append("id,label,searches,items_scanned,candidates_rejected,matches_produced,filter_time_ms,sort_time_ms,last_filter_time_ms,last_sort_time_ms,latency_max_ms");
+    for (int i = 0; i < ComboPerfCounters::LatencyBucketCount; ++i)
+        out_buf.appendf(",latency_bucket_%d", i);
+    out_buf.append("\n");
+
+    for (const auto& [id, counters] : Internal::gComboPerfCounters) {
+        // Quote the label and double its quotes, as CSV expects
+        out_buf.appendf("%u,\"", id);
+        for (const char* c = counters.Label; *c != '\0'; ++c) {
+            const char* next = c + 1;
+            out_buf.append(c, next);
+            if (*c == '"')
+                out_buf.append(c, next);
+        }
+        out_buf.appendf("\",%d,%lld,%lld,%lld,%.4f,%.4f,%.4f,%.4f,%.4f",
+            counters.SearchCount, counters.ItemsScanned, counters.CandidatesRejected, counters.MatchesProduced,
+            counters.FilterTime * 1e3, counters.SortTime * 1e3, counters.LastFilterTime * 1e3, counters.LastSortTime * 1e3, counters.LatencyMax * 1e3);
+        for (int i = 0; i < ComboPerfCounters::LatencyBucketCount; ++i)
+            out_buf.appendf(",%d", counters.LatencyHistogram[i]);
+        out_buf.append("\n");
+    }
 }
 
 namespace Internal
@@ -199,41 +852,1701 @@ float CalcComboItemHeight(int item_count, float offset_multiplier)
     return item_count < 0 ? FLT_MAX : (g->FontSize + g->Style.ItemSpacing.y) * item_count - g->Style.ItemSpacing.y + (g->Style.WindowPadding.y * offset_multiplier);
 }
 
-void SetScrollToComboItemJump(ImGuiWindow* listbox_window, int index)
+int ClampComboListedRows(int row_count)
+{
+    const ImGuiContext* g = GImGui;
+    return ImMin(row_count, static_cast<int>(ComboMaxListedHeight / (g->FontSize + g->Style.ItemSpacing.y)));
+}
+
+// The widgets keep the virtual scroll of the list box they are showing in its state storage, for the scroll to item helpers
+static ComboVirtualScroll* FindComboVirtualScroll(ImGuiWindow* listbox_window)
 {
+    return static_cast<ComboVirtualScroll*>(listbox_window->StateStorage.GetVoidPtr(ImHashStr("ComboVirtualScroll")));
+}
+
+// Moves the logical position, and the physical scroll with it right away so the scrollbar drawn by the next Begin() is not a frame behind the rows
+static void SetComboVirtualScrollTopRow(ComboVirtualScroll& virtual_scroll, ImGuiWindow* listbox_window, double top_row)
+{
+    virtual_scroll.SetTopRow(top_row);
+    const float scroll_max = listbox_window->ScrollMax.y;
+    listbox_window->Scroll.y = virtual_scroll.MaxTopRow > 0.0 ? static_cast<float>(virtual_scroll.TopRow / virtual_scroll.MaxTopRow * scroll_max) : 0.0f;
+    virtual_scroll.LastScrollY = listbox_window->Scroll.y;
+}
+
+void ClearComboVirtualScroll(ComboVirtualScroll& virtual_scroll, ImGuiWindow* listbox_window)
+{
+    listbox_window->StateStorage.SetVoidPtr(ImHashStr("ComboVirtualScroll"), NULL);
+    virtual_scroll.Active = false;
+    virtual_scroll.LastScrollY = -1.0f;
+}
+
+ComboVirtualScroll* UpdateComboVirtualScroll(ComboVirtualScroll& virtual_scroll, ImGuiWindow* listbox_window, int row_count)
+{
+    const ImGuiContext& g = *GImGui;
+    const double row_height = g.FontSize + g.Style.ItemSpacing.y;
+    if (row_count * row_height <= ComboVirtualScroll::MaxPhysicalHeight) {
+        ClearComboVirtualScroll(virtual_scroll, listbox_window);
+        return NULL;
+    }
+    virtual_scroll.Active = true;
+    listbox_window->StateStorage.SetVoidPtr(ImHashStr("ComboVirtualScroll"), &virtual_scroll);
+
+    virtual_scroll.ViewTop = listbox_window->DC.CursorPos.y + listbox_window->Scroll.y;
+    virtual_scroll.VisibleRows = ImMax(1.0, (listbox_window->InnerRect.GetHeight() - listbox_window->WindowPadding.y * 2.0f) / row_height);
+    virtual_scroll.MaxTopRow = ImMax(0.0, row_count - virtual_scroll.VisibleRows);
+
+    // Dear ImGui already applied this frame's wheel and scrollbar to the physical scroll, find out which one it was
+    const float scroll_max = listbox_window->ScrollMax.y;
+    if (listbox_window->Scroll.y != virtual_scroll.LastScrollY) {
+        if (g.IO.MouseWheel != 0.0f && g.HoveredWindow == listbox_window)
+            SetComboVirtualScrollTopRow(virtual_scroll, listbox_window, virtual_scroll.TopRow - g.IO.MouseWheel * ImMin(5.0, virtual_scroll.VisibleRows * 0.67)); // Same step as Dear ImGui
+        else
+            SetComboVirtualScrollTopRow(virtual_scroll, listbox_window, scroll_max > 0.0f ? listbox_window->Scroll.y / scroll_max * virtual_scroll.MaxTopRow : 0.0);
+    }
+    else {
+        SetComboVirtualScrollTopRow(virtual_scroll, listbox_window, virtual_scroll.TopRow);
+    }
+    return &virtual_scroll;
+}
+
+void SetScrollToComboItemJump(ImGuiWindow* listbox_window, int index, const ComboRowHeights* heights)
+{
+    if (ComboVirtualScroll* virtual_scroll = FindComboVirtualScroll(listbox_window)) {
+        SetComboVirtualScrollTopRow(*virtual_scroll, listbox_window, index + 0.5 - virtual_scroll->VisibleRows * 0.5);
+        return;
+    }
+
     const ImGuiContext& g = *GImGui;
     float spacing_y = ImMax(listbox_window->WindowPadding.y, g.Style.ItemSpacing.y);
-    float temp_pos = (g.Font->FontSize + g.Style.ItemSpacing.y) * index;
-    float new_pos = ImLerp(temp_pos - spacing_y, temp_pos + g.FontSize + g.Style.ItemSpacing.y + spacing_y, 0.5f) - listbox_window->Scroll.y;
+    float temp_pos = heights ? heights->GetTop(index) : (g.Font->FontSize + g.Style.ItemSpacing.y) * index;
+    float row_height = heights ? heights->GetHeight(index) : g.FontSize + g.Style.ItemSpacing.y;
+    float new_pos = ImLerp(temp_pos - spacing_y, temp_pos + row_height + spacing_y, 0.5f) - listbox_window->Scroll.y;
     ImGui::SetScrollFromPosY(listbox_window, new_pos + 2.50f, 0.5f);
 }
 
-void SetScrollToComboItemUp(ImGuiWindow* listbox_window, int index)
+void SetScrollToComboItemUp(ImGuiWindow* listbox_window, int index, const ComboRowHeights* heights)
 {
+    if (ComboVirtualScroll* virtual_scroll = FindComboVirtualScroll(listbox_window)) {
+        if (index < virtual_scroll->TopRow)
+            SetComboVirtualScrollTopRow(*virtual_scroll, listbox_window, index);
+        return;
+    }
+
     const ImGuiContext& g = *GImGui;
-    float item_pos = (g.FontSize + g.Style.ItemSpacing.y) * index;
+    float item_pos = heights ? heights->GetTop(index) : (g.FontSize + g.Style.ItemSpacing.y) * index;
     float diff = item_pos - listbox_window->Scroll.y;
     if (diff < 0.0f)
         listbox_window->Scroll.y += diff - 1.0f;
 }
 
-void SetScrollToComboItemDown(ImGuiWindow* listbox_window, int index)
+void SetScrollToComboItemDown(ImGuiWindow* listbox_window, int index, const ComboRowHeights* heights)
 {
+    if (ComboVirtualScroll* virtual_scroll = FindComboVirtualScroll(listbox_window)) {
+        if (index + 1 > virtual_scroll->TopRow + virtual_scroll->VisibleRows)
+            SetComboVirtualScrollTopRow(*virtual_scroll, listbox_window, index + 1 - virtual_scroll->VisibleRows);
+        return;
+    }
+
     const ImGuiContext& g = *GImGui;
-    const float item_pos_lower = (g.FontSize + g.Style.ItemSpacing.y) * (index + 1);
+    const float item_pos_lower = heights ? heights->GetTop(index + 1) : (g.FontSize + g.Style.ItemSpacing.y) * (index + 1);
     const float diff = item_pos_lower - listbox_window->Size.y - listbox_window->Scroll.y;
     if (diff > 0.0f)
         listbox_window->Scroll.y += diff + 1.0f;
 }
 
-void UpdateInputTextAndCursor(char* buf, int buf_capacity, const char* new_str)
+// Writes the event header, returns false if the combo is not being recorded
+static bool BeginComboSessionEvent(ImGuiID combo_id, ComboSessionEventType type)
 {
-    strncpy(buf, new_str, buf_capacity);
+    ComboSessionRecorder& recorder = gComboSessionRecorder;
+    if (recorder.ComboID != combo_id)
+        return false;
 
-    ImGuiContext& g = *GImGui;
-    ImGuiInputTextState& intxt_state = g.InputTextState;
-    const char* buf_end = NULL;
-    intxt_state.CurLenW = ImTextStrFromUtf8(intxt_state.TextW.Data, intxt_state.TextW.Size, buf, NULL, &buf_end);
+    const double time = GetComboPerfTime();
+    const double delta_us = (time - recorder.LastEventTime) * 1e6;
+    recorder.LastEventTime = time;
+    WriteComboSessionVarint(recorder.Buffer, delta_us > 0.0 ? static_cast<unsigned long long>(delta_us) : 0);
+    recorder.Buffer.push_back(static_cast<unsigned char>(type));
+    return true;
+}
+
+void RecordComboSessionEvent(ImGuiID combo_id, ComboSessionEventType type, int value)
+{
+    IM_ASSERT(type != ComboSessionEvent_Open && type != ComboSessionEvent_Query);
+    if (BeginComboSessionEvent(combo_id, type) && type == ComboSessionEvent_Select)
+        WriteComboSessionVarint(gComboSessionRecorder.Buffer, static_cast<unsigned int>(value));
+}
+
+void RecordComboSessionOpen(ImGuiID combo_id, int widget_kind, ImGuiComboFlags flags, int item_count)
+{
+    if (!BeginComboSessionEvent(combo_id, ComboSessionEvent_Open))
+        return;
+    WriteComboSessionVarint(gComboSessionRecorder.Buffer, static_cast<unsigned int>(widget_kind));
+    WriteComboSessionVarint(gComboSessionRecorder.Buffer, static_cast<unsigned int>(flags));
+    WriteComboSessionVarint(gComboSessionRecorder.Buffer, static_cast<unsigned int>(item_count));
+}
+
+void RecordComboSessionQuery(ImGuiID combo_id, const char* query)
+{
+    if (!BeginComboSessionEvent(combo_id, ComboSessionEvent_Query))
+        return;
+    const int length = static_cast<int>(strlen(query));
+    WriteComboSessionVarint(gComboSessionRecorder.Buffer, static_cast<unsigned int>(length));
+    for (int i = 0; i < length; ++i)
+        gComboSessionRecorder.Buffer.push_back(static_cast<unsigned char>(query[i]));
+}
+
+#ifdef IMGUI_COMBO_FILTER_ENABLE_TRACING
+void ComboTraceBegin(ComboTracePhase phase, ImGuiID combo_id)
+{
+    if (phase == ComboTracePhase_Search)
+        gComboTraceSearchID = combo_id;
+    if (gComboTraceHooks.Begin)
+        gComboTraceHooks.Begin(phase, combo_id, gComboTraceHooks.UserData);
+}
+
+void ComboTraceEnd(ComboTracePhase phase, ImGuiID combo_id)
+{
+    if (gComboTraceHooks.End)
+        gComboTraceHooks.End(phase, combo_id, gComboTraceHooks.UserData);
+    if (phase == ComboTracePhase_Search)
+        gComboTraceSearchID = 0;
+}
+#endif
+
+#ifndef IMGUI_COMBO_FILTER_DISABLE_PERF_COUNTERS
+ComboPerfCounters* BeginComboPerfSearch(ImGuiID combo_id, const char* combo_label)
+{
+    if (!gComboPerfCountersEnabled)
+        return nullptr;
+
+    auto [it, inserted] = gComboPerfCounters.try_emplace(combo_id);
+    ComboPerfCounters& counters = it->second;
+    if (inserted)
+        ImStrncpy(counters.Label, combo_label, IM_ARRAYSIZE(counters.Label));
+    counters.SortTimeInSearch = 0.0;
+    counters.SearchStartTime = GetComboPerfTime();
+    gCurrentComboPerfCounters = &counters;
+    return &counters;
+}
+
+void EndComboPerfSearch(ComboPerfCounters* counters, int items_scanned, int matches_produced)
+{
+    gCurrentComboPerfCounters = nullptr;
+    if (!counters)
+        return;
+
+    const double search_time = GetComboPerfTime() - counters->SearchStartTime;
+    counters->SearchCount += 1;
+    counters->ItemsScanned += items_scanned;
+    counters->MatchesProduced += matches_produced;
+    counters->CandidatesRejected += items_scanned - matches_produced;
+    counters->LastSortTime = counters->SortTimeInSearch;
+    counters->LastFilterTime = search_time - counters->SortTimeInSearch;
+    counters->SortTime += counters->LastSortTime;
+    counters->FilterTime += counters->LastFilterTime;
+
+    // The results are listed on the next frame. Keep the oldest keystroke if several are typed before that
+    if (counters->PendingKeystrokeTime < 0.0)
+        counters->PendingKeystrokeTime = counters->SearchStartTime;
+}
+
+void RecordComboPerfResultsShown(ImGuiID combo_id)
+{
+    if (!gComboPerfCountersEnabled)
+        return;
+
+    auto it = gComboPerfCounters.find(combo_id);
+    if (it == gComboPerfCounters.end() || it->second.PendingKeystrokeTime < 0.0)
+        return;
+
+    ComboPerfCounters& counters = it->second;
+    const double latency = GetComboPerfTime() - counters.PendingKeystrokeTime;
+    counters.PendingKeystrokeTime = -1.0;
+    counters.LatencyMax = ImMax(counters.LatencyMax, latency);
+
+    int bucket = 0;
+    for (double us = latency * 1e6; us >= 1.0 && bucket < ComboPerfCounters::LatencyBucketCount - 1; us *= 0.5)
+        ++bucket;
+    counters.LatencyHistogram[bucket] += 1;
+}
+#endif
+
+ComboListRows BeginComboListRows(int row_count, const ComboRowHeights* heights, const ComboVirtualScroll* virtual_scroll)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    const ImGuiStyle& style = g.Style;
+
+    ComboListRows rows;
+    rows.StartPos = window->DC.CursorPos;
+    rows.RowHeight = g.FontSize + style.ItemSpacing.y;
+    rows.MaxX = window->WorkRect.Max.x;
+    rows.Heights = heights;
+    if (virtual_scroll && virtual_scroll->Active) {
+        // Rows are positioned relative to the first visible one, so positions stay small whatever the row count
+        rows.VirtualScroll = virtual_scroll;
+        rows.BaseRow = static_cast<int>(virtual_scroll->TopRow);
+        rows.StartPos.y = virtual_scroll->ViewTop - static_cast<float>(virtual_scroll->TopRow - rows.BaseRow) * rows.RowHeight;
+    }
+
+    // Same bounding box as the Selectable() rows, which are padded with half the item spacing, clamped to the visible part of the list box
+    const float spacing_l = IM_FLOOR(style.ItemSpacing.x * 0.50f);
+    const float spacing_u = IM_FLOOR(style.ItemSpacing.y * 0.50f);
+    const float total_height = heights ? heights->GetTotalHeight() : rows.RowHeight * (row_count - rows.BaseRow);
+    ImRect bb(rows.StartPos.x - spacing_l, rows.StartPos.y - spacing_u, rows.MaxX + style.ItemSpacing.x - spacing_l, rows.StartPos.y - spacing_u + total_height);
+    bb.Min.y = ImMax(bb.Min.y, window->ClipRect.Min.y);
+    bb.Max.y = ImMin(bb.Max.y, window->ClipRect.Max.y);
+
+    const ImGuiID id = window->GetID("##combo_rows");
+    if (row_count <= 0 || bb.Min.y >= bb.Max.y || !ItemAdd(bb, id))
+        return rows;
+
+    auto row_at = [&](float y) {
+        return heights ? heights->FindRow(y - rows.StartPos.y + spacing_u) : ImClamp(rows.BaseRow + static_cast<int>((y - rows.StartPos.y + spacing_u) / rows.RowHeight), 0, row_count - 1);
+    };
+    bool hovered, held;
+    const bool pressed = ButtonBehavior(bb, id, &hovered, &held);
+    rows.Held = held;
+    if (hovered)
+        rows.HoveredRow = row_at(g.IO.MousePos.y);
+    // The rows share the same id, so a click is only accepted if it is released on the row it started on, like separate items would
+    if (pressed && rows.HoveredRow == row_at(g.IO.MouseClickedPos[0].y))
+        rows.PressedRow = rows.HoveredRow;
+    return rows;
+}
+
+void RenderComboListRow(const ComboListRows& rows, int row, const char* label, bool selected, float label_width)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    const ImGuiStyle& style = g.Style;
+
+    // The clipper positions the cursor on the first listed row, the next ones follow
+    const ImVec2 pos = window->DC.CursorPos;
+    const float row_height = rows.Heights ? rows.Heights->GetHeight(row) : rows.RowHeight;
+    window->DC.CursorPos.y += row_height;
+
+    const bool hovered = row == rows.HoveredRow;
+    if (hovered || selected) {
+        const float spacing_l = IM_FLOOR(style.ItemSpacing.x * 0.50f);
+        const float spacing_u = IM_FLOOR(style.ItemSpacing.y * 0.50f);
+        const ImRect bb(pos.x - spacing_l, pos.y - spacing_u, rows.MaxX + style.ItemSpacing.x - spacing_l, pos.y + row_height - spacing_u);
+        const ImU32 col = GetColorU32((rows.Held && hovered) ? ImGuiCol_HeaderActive : hovered ? ImGuiCol_HeaderHovered : ImGuiCol_Header);
+        RenderFrame(bb.Min, bb.Max, col, false, 0.0f);
+    }
+
+    // Labels of unknown width are left to the list box clipping, measuring them would defeat the purpose of these rows
+    // Multi-line labels are clipped too, the ellipsis is only for a single line
+    if (label_width > rows.MaxX - pos.x && row_height <= rows.RowHeight) {
+        const ImVec2 label_size(label_width, g.FontSize);
+        RenderTextEllipsis(window->DrawList, pos, ImVec2(rows.MaxX, pos.y + rows.RowHeight), rows.MaxX, rows.MaxX, label, NULL, &label_size);
+        return;
+    }
+
+    ImVec2 text_pos = pos;
+    if (style.SelectableTextAlign.x > 0.0f)
+        text_pos.x += ImMax(0.0f, (rows.MaxX - pos.x - (label_width < 0.0f ? CalcTextSize(label).x : label_width)) * style.SelectableTextAlign.x);
+    window->DrawList->AddText(g.Font, g.FontSize, text_pos, GetColorU32(ImGuiCol_Text), label);
+}
+
+void ComboData::SetInitialValues(const char* preview, int index)
+{
+    if (preview == NULL)
+        preview = "";
+    const int length = static_cast<int>(strlen(preview)) + 1;
+    InitialValues.Preview.resize(length);
+    memcpy(InitialValues.Preview.Data, preview, length);
+    InitialValues.Index = index;
+}
+
+size_t ComboData::CalcMemoryUsage() const noexcept
+{
+    return sizeof(*this) + InitialValues.Preview.Capacity + RowHeights.Extra.Capacity * sizeof(float) + RowHeights.Measured.Capacity * sizeof(ImU32) + DrawCache.Vertices.Capacity * sizeof(ImDrawVert) + DrawCache.Indices.Capacity * sizeof(ImDrawIdx);
+}
+
+ImGuiID CalcComboDrawSignature(const ComboListRows& rows, int row_count, int selection, const char* query, int items_count, int items_version, int measured_widths)
+{
+    ImGuiContext& g = *GImGui;
+    const ImGuiWindow* window = g.CurrentWindow;
+    struct
+    {
+        const void* Font;
+        float       StartPos[2], ClipRect[4], MaxX, FontSize;
+        int         BaseRow, HoveredRow, Held, Selection, RowCount, ItemsCount, ItemsVersion, MeasuredWidths, MeasuredRows;
+        ImU32       Colors[4];
+    } state;
+    memset(&state, 0, sizeof(state)); // Padding is hashed too
+    state.Font = g.Font;
+    state.StartPos[0] = rows.StartPos.x;
+    state.StartPos[1] = rows.StartPos.y;
+    state.ClipRect[0] = window->ClipRect.Min.x;
+    state.ClipRect[1] = window->ClipRect.Min.y;
+    state.ClipRect[2] = window->ClipRect.Max.x;
+    state.ClipRect[3] = window->ClipRect.Max.y;
+    state.MaxX = rows.MaxX;
+    state.FontSize = g.FontSize;
+    state.BaseRow = rows.BaseRow;
+    state.HoveredRow = rows.HoveredRow;
+    state.Held = rows.Held;
+    state.Selection = selection;
+    state.RowCount = row_count;
+    state.ItemsCount = items_count;
+    state.ItemsVersion = items_version;
+    state.MeasuredWidths = measured_widths;
+    state.MeasuredRows = rows.Heights ? rows.Heights->GetMeasuredCount() : 0;
+    state.Colors[0] = GetColorU32(ImGuiCol_Text);
+    state.Colors[1] = GetColorU32(ImGuiCol_Header);
+    state.Colors[2] = GetColorU32(ImGuiCol_HeaderHovered);
+    state.Colors[3] = GetColorU32(ImGuiCol_HeaderActive);
+    return ImHashData(&state, sizeof(state), ImHashStr(query));
+}
+
+void ComboColumnTextCache::Validate(int items_version, int items_count)
+{
+    if (ItemsVersion != items_version || ItemsCount != items_count) {
+        Clear();
+        ItemsVersion = items_version;
+        ItemsCount = items_count;
+    }
+    else if (Entries.Size >= MaxEntries) {
+        DropOldest(MaxEntries / 2);
+    }
+}
+
+static ImGuiID GetComboColumnTextKey(int item_index, int column)
+{
+    const int key[2]{ item_index, column };
+    return ImHashData(key, sizeof(key));
+}
+
+const char* ComboColumnTextCache::Find(int item_index, int column) const
+{
+    const int entry_index = Lookup.GetInt(GetComboColumnTextKey(item_index, column)) - 1;
+    if (entry_index < 0)
+        return NULL;
+    const Entry& entry = Entries[entry_index];
+    return entry.ItemIndex == item_index && entry.Column == column ? Texts.Data + entry.TextOffset : NULL; // Hash collisions are fetched again
+}
+
+const char* ComboColumnTextCache::Add(int item_index, int column, const char* text)
+{
+    if (text == NULL)
+        text = "";
+    const int length = static_cast<int>(strlen(text)) + 1;
+    const int offset = Texts.Size;
+    Texts.resize(offset + length);
+    memcpy(Texts.Data + offset, text, length);
+    Lookup.SetInt(GetComboColumnTextKey(item_index, column), Entries.Size + 1);
+    Entries.push_back({ item_index, column, offset });
+    return Texts.Data + offset;
+}
+
+void ComboColumnTextCache::DropOldest(int count)
+{
+    count = ImMin(count, Entries.Size);
+    const int text_offset = count < Entries.Size ? Entries[count].TextOffset : Texts.Size;
+    Entries.erase(Entries.Data, Entries.Data + count);
+    Texts.erase(Texts.Data, Texts.Data + text_offset);
+
+    // The lookup is built again in one sort, rather than removing the dropped entries one by one
+    Lookup.Clear();
+    Lookup.Data.reserve(Entries.Size);
+    for (int i = 0; i < Entries.Size; ++i) {
+        Entries[i].TextOffset -= text_offset;
+        Lookup.Data.push_back(ImGuiStoragePair(GetComboColumnTextKey(Entries[i].ItemIndex, Entries[i].Column), i + 1));
+    }
+    Lookup.BuildSortByKey();
+}
+
+void ComboColumnTextCache::Clear()
+{
+    Lookup.Clear();
+    Entries.clear();
+    Texts.clear();
+}
+
+size_t ComboColumnTextCache::CalcMemoryUsage() const
+{
+    return sizeof(*this) + Lookup.Data.Capacity * sizeof(ImGuiStoragePair) + Entries.Capacity * sizeof(Entry) + Texts.Capacity;
+}
+
+void ComboQueryHistory::Validate(ImGuiID engine_id, ImGuiID items_signature)
+{
+    if (EngineID != engine_id || ItemsSignature != items_signature) {
+        Clear();
+        EngineID = engine_id;
+        ItemsSignature = items_signature;
+    }
+}
+
+void ComboQueryHistory::Truncate(const char* query)
+{
+    while (!Entries.empty() && strncmp(Entries.back().Query.Data, query, Entries.back().Query.Size - 1) != 0) {
+        EntriesBytes -= CalcEntryMemoryUsage(Entries.back());
+        Entries.pop_back();
+    }
+}
+
+void ComboQueryHistory::Push(const char* query, const ComboFilterSearchResults& results, const ComboFilterRanking& ranking)
+{
+    const size_t query_size = strlen(query) + 1;
+    const size_t entry_bytes = query_size + results.size() * sizeof(ComboFilterSearchResultData);
+    if (entry_bytes > MaxBytes)
+        return;
+
+    // Dropping the shortest queries until the new entry fits
+    size_t drop_count = 0;
+    size_t bytes = EntriesBytes;
+    while (drop_count < Entries.size() && (static_cast<int>(Entries.size() - drop_count) >= MaxEntries || bytes + entry_bytes > MaxBytes))
+        bytes -= CalcEntryMemoryUsage(Entries[drop_count++]);
+    Entries.erase(Entries.begin(), Entries.begin() + drop_count);
+
+    Entry& entry = Entries.emplace_back();
+    entry.Query.resize(static_cast<int>(query_size));
+    memcpy(entry.Query.Data, query, query_size);
+    entry.Results = results;
+    entry.Ranking = ranking;
+    EntriesBytes = bytes + CalcEntryMemoryUsage(entry);
+}
+
+size_t ComboQueryHistory::CalcEntryMemoryUsage(const Entry& entry)
+{
+    return entry.Query.Capacity + entry.Results.capacity() * sizeof(ComboFilterSearchResultData);
+}
+
+size_t ComboQueryHistory::CalcMemoryUsage() const
+{
+    return sizeof(*this) + Entries.capacity() * sizeof(Entry) + EntriesBytes;
+}
+
+// Scores as unsigned keys sorting in the requested order
+static inline ImU32 GetComboFilterSortKey(int score, bool descending)
+{
+    const ImU32 key = static_cast<ImU32>(score) ^ 0x80000000u;
+    return descending ? ~key : key;
+}
+
+void SortFilterResultsStable(ComboFilterSearchResults& results, bool descending)
+{
+    const int count = static_cast<int>(results.size());
+    if (count <= SortInsertionThreshold) {
+        for (int i = 1; i < count; ++i) {
+            const ComboFilterSearchResultData result = results[i];
+            const ImU32 key = GetComboFilterSortKey(result.Score, descending);
+            int j = i;
+            for (; j > 0 && GetComboFilterSortKey(results[j - 1].Score, descending) > key; --j)
+                results[j] = results[j - 1];
+            results[j] = result;
+        }
+        return;
+    }
+
+    // LSD radix sort over the 4 bytes of the keys, skipping the bytes every key shares (most of them, scores being small integers)
+    ImU32 histograms[4][256];
+    memset(histograms, 0, sizeof(histograms));
+    for (const ComboFilterSearchResultData& result : results) {
+        const ImU32 key = GetComboFilterSortKey(result.Score, descending);
+        for (int digit = 0; digit < 4; ++digit)
+            ++histograms[digit][(key >> (digit * 8)) & 0xFF];
+    }
+
+    // The scratch buffer only lives for the sort, through the ImGui allocator so it shows in the allocation metrics
+    ComboFilterSearchResultData* scratch = static_cast<ComboFilterSearchResultData*>(IM_ALLOC(results.size() * sizeof(ComboFilterSearchResultData)));
+    ComboFilterSearchResultData* src = results.data();
+    ComboFilterSearchResultData* dst = scratch;
+    for (int digit = 0; digit < 4; ++digit) {
+        ImU32* histogram = histograms[digit];
+        const ImU32 first_key_bucket = (GetComboFilterSortKey(src[0].Score, descending) >> (digit * 8)) & 0xFF;
+        if (histogram[first_key_bucket] == static_cast<ImU32>(count))
+            continue;
+        ImU32 offset = 0;
+        for (int bucket = 0; bucket < 256; ++bucket) {
+            const ImU32 bucket_count = histogram[bucket];
+            histogram[bucket] = offset;
+            offset += bucket_count;
+        }
+        for (int i = 0; i < count; ++i)
+            dst[histogram[(GetComboFilterSortKey(src[i].Score, descending) >> (digit * 8)) & 0xFF]++] = src[i];
+        std::swap(src, dst);
+    }
+    if (src != results.data())
+        memcpy(results.data(), src, results.size() * sizeof(ComboFilterSearchResultData));
+    IM_FREE(scratch);
+}
+
+static bool IsComboFilterResultBefore(const ComboFilterSearchResultData& a, const ComboFilterSearchResultData& b)
+{
+    return a.Score > b.Score || (a.Score == b.Score && a.Index < b.Index);
+}
+
+void MergeComboFilterResults(ComboFilterSearchResults& results, int begin, int mid, int end)
+{
+    std::sort(results.begin() + mid, results.begin() + end, IsComboFilterResultBefore);
+    std::inplace_merge(results.begin() + begin, results.begin() + mid, results.begin() + end, IsComboFilterResultBefore);
+}
+
+void GetComboNarrowedCandidates(const ComboFilterSearchResults& previous_results, ImVector<int>& out_indexes)
+{
+    out_indexes.resize(static_cast<int>(previous_results.size()));
+    for (int i = 0; i < out_indexes.Size; ++i)
+        out_indexes[i] = previous_results[i].Index;
+    std::sort(out_indexes.begin(), out_indexes.end());
+}
+
+ImGuiID CalcComboResumeStateKey(ImGuiID items_signature, const char* query)
+{
+    return ImHashStr(query, 0, items_signature);
+}
+
+const ImVector<ComboResumeMatch>* FindComboResumeState(ImGuiID key)
+{
+    for (ComboResumeState& state : gComboResumeStates) {
+        if (state.Key == key) {
+            state.LastUsed = ++gComboResumeStateClock;
+            return &state.Matches;
+        }
+    }
+    return NULL;
+}
+
+void AddComboResumeState(ImGuiID key, ImVector<ComboResumeMatch>& matches)
+{
+    const size_t bytes = matches.Capacity * sizeof(ComboResumeMatch);
+    for (size_t i = 0; i < gComboResumeStates.size(); ++i) {
+        if (gComboResumeStates[i].Key == key) {
+            gComboResumeStateBytes -= gComboResumeStates[i].CalcMemoryUsage();
+            gComboResumeStates.erase(gComboResumeStates.begin() + i);
+            break;
+        }
+    }
+    if (bytes > MaxComboResumeStateBytes)
+        return;
+
+    // Dropping the least recently used states until the new one fits
+    while (!gComboResumeStates.empty() && (static_cast<int>(gComboResumeStates.size()) >= MaxComboResumeStates || gComboResumeStateBytes + bytes > MaxComboResumeStateBytes)) {
+        auto lru = std::min_element(gComboResumeStates.begin(), gComboResumeStates.end(), [](const ComboResumeState& a, const ComboResumeState& b) { return a.LastUsed < b.LastUsed; });
+        gComboResumeStateBytes -= lru->CalcMemoryUsage();
+        gComboResumeStates.erase(lru);
+    }
+    ComboResumeState& state = gComboResumeStates.emplace_back();
+    state.Key = key;
+    state.LastUsed = ++gComboResumeStateClock;
+    state.Matches.swap(matches);
+    gComboResumeStateBytes += state.CalcMemoryUsage();
+}
+
+void ClearComboResumeStates()
+{
+    gComboResumeStates.clear();
+    gComboResumeStateBytes = 0;
+}
+
+bool ComboDrawCache::Replay(ImGuiID signature, const ComboListRows& rows)
+{
+    if (!Valid || Signature != signature)
+        return false;
+
+    ImGuiWindow* window = GImGui->CurrentWindow;
+    ImDrawList* draw_list = window->DrawList;
+    if (!Indices.empty()) {
+        draw_list->PrimReserve(Indices.Size, Vertices.Size);
+        const unsigned int base_idx = draw_list->_VtxCurrentIdx; // Read after PrimReserve(), which can start a new command with a new vertex offset
+        memcpy(draw_list->_VtxWritePtr, Vertices.Data, Vertices.size_in_bytes());
+        for (int i = 0; i < Indices.Size; ++i)
+            draw_list->_IdxWritePtr[i] = static_cast<ImDrawIdx>(base_idx + Indices[i]);
+        draw_list->_VtxWritePtr += Vertices.Size;
+        draw_list->_IdxWritePtr += Indices.Size;
+        draw_list->_VtxCurrentIdx += Vertices.Size;
+    }
+
+    // Same layout as the drawn rows
+    window->DC.CursorPos.y = rows.StartPos.y + CursorEndY;
+    window->DC.CursorMaxPos.y = ImMax(window->DC.CursorMaxPos.y, rows.StartPos.y + CursorMaxY);
+    return true;
+}
+
+void ComboDrawCache::BeginRecord()
+{
+    const ImDrawList* draw_list = GImGui->CurrentWindow->DrawList;
+    RecordVtxStart = draw_list->VtxBuffer.Size;
+    RecordIdxStart = draw_list->IdxBuffer.Size;
+    RecordCmdCount = draw_list->CmdBuffer.Size;
+    RecordVtxCurrentIdx = draw_list->_VtxCurrentIdx;
+}
+
+void ComboDrawCache::EndRecord(ImGuiID signature, const ComboListRows& rows)
+{
+    const ImGuiWindow* window = GImGui->CurrentWindow;
+    const ImDrawList* draw_list = window->DrawList;
+
+    // Rows that needed a new draw command (16-bit indices running out) are not cached, the indices would not be relative to a single vertex
+    Valid = draw_list->CmdBuffer.Size == RecordCmdCount;
+    if (!Valid)
+        return;
+
+    const int vtx_count = draw_list->VtxBuffer.Size - RecordVtxStart;
+    const int idx_count = draw_list->IdxBuffer.Size - RecordIdxStart;
+    Vertices.resize(vtx_count);
+    Indices.resize(idx_count);
+    if (vtx_count > 0)
+        memcpy(Vertices.Data, draw_list->VtxBuffer.Data + RecordVtxStart, vtx_count * sizeof(ImDrawVert));
+    for (int i = 0; i < idx_count; ++i)
+        Indices[i] = static_cast<ImDrawIdx>(draw_list->IdxBuffer[RecordIdxStart + i] - RecordVtxCurrentIdx);
+    Signature = signature;
+    CursorEndY = window->DC.CursorPos.y - rows.StartPos.y;
+    CursorMaxY = window->DC.CursorMaxPos.y - rows.StartPos.y;
+}
+
+float ComboRowHeights::GetRowHeight(const char* label) const
+{
+    int line_count = 1;
+    for (const char* c = label; *c != '\0'; ++c)
+        line_count += *c == '\n';
+    return LineHeight * line_count + Spacing;
+}
+
+float ComboRowHeights::GetTop(int row) const
+{
+    float top = row * GetEstimatedHeight();
+    for (int node = ImMin(row, Extra.Size); node > 0; node -= node & -node)
+        top += Extra[node - 1];
+    return top;
+}
+
+int ComboRowHeights::FindRow(float y) const
+{
+    if (RowCount <= 0)
+        return 0;
+
+    // Descends the tree for the last row whose top is above 'y', the tops are increasing since a row is never shorter than its estimate
+    const float estimated_height = GetEstimatedHeight();
+    int row = 0;
+    float extra = 0.0f;
+    int step = 1;
+    while (step * 2 <= Extra.Size)
+        step *= 2;
+    for (; step > 0; step >>= 1) {
+        if (row + step <= Extra.Size && (row + step) * estimated_height + extra + Extra[row + step - 1] <= y) {
+            row += step;
+            extra += Extra[row - 1];
+        }
+    }
+    return ImClamp(row, 0, RowCount - 1);
+}
+
+void ComboRowHeights::Resize(int row_count)
+{
+    const int old_count = Extra.Size;
+    RowCount = row_count;
+    if (row_count <= old_count)
+        return;
+    Measured.resize((row_count + 31) >> 5, 0u);
+    if (old_count == 0) {
+        Extra.resize(row_count, 0.0f);
+        return;
+    }
+
+    // Appended nodes cover rows that are all estimated, except the ones already in the tree: their sum is the difference of two prefix sums
+    Extra.resize(row_count);
+    for (int node = old_count + 1; node <= row_count; ++node) {
+        float sum = 0.0f;
+        for (int i = node - 1; i > node - (node & -node); i -= i & -i)
+            sum += Extra[i - 1];
+        Extra[node - 1] = sum;
+    }
+}
+
+void ComboRowHeights::SetMeasuredHeight(int row, float height)
+{
+    IM_ASSERT(row >= 0 && row < RowCount && !IsMeasured(row));
+    Measured[row >> 5] |= 1u << (row & 31);
+    ++MeasuredCount;
+    const float extra = height - GetEstimatedHeight();
+    for (int node = row + 1; node <= Extra.Size; node += node & -node)
+        Extra[node - 1] += extra;
+}
+
+void ComboListClipper::Begin(const ComboListRows& rows, int row_count)
+{
+    Rows = &rows;
+    RowCount = row_count;
+    StepNo = 0;
+    if (rows.Heights == NULL && rows.VirtualScroll == NULL)
+        Clipper.Begin(row_count, rows.RowHeight);
+}
+
+bool ComboListClipper::Step()
+{
+    if (Rows->Heights == NULL && Rows->VirtualScroll == NULL) {
+        const bool ret = Clipper.Step();
+        DisplayStart = Clipper.DisplayStart;
+        DisplayEnd = Clipper.DisplayEnd;
+        return ret;
+    }
+
+    ImGuiWindow* window = GImGui->CurrentWindow;
+    const ComboRowHeights* heights = Rows->Heights;
+    if (StepNo++ == 0 && RowCount > 0) {
+        if (heights) {
+            DisplayStart = heights->FindRow(window->ClipRect.Min.y - Rows->StartPos.y);
+            DisplayEnd = heights->FindRow(window->ClipRect.Max.y - Rows->StartPos.y) + 1;
+            window->DC.CursorPos.y = Rows->StartPos.y + heights->GetTop(DisplayStart);
+        }
+        else {
+            DisplayStart = Rows->BaseRow;
+            DisplayEnd = ImMin(RowCount, Rows->BaseRow + static_cast<int>((window->ClipRect.Max.y - Rows->StartPos.y) / Rows->RowHeight) + 1);
+            window->DC.CursorPos.y = Rows->StartPos.y;
+        }
+        return true;
+    }
+
+    // Lay out the whole content height, so the scrollbar covers every row (or the whole physical range when virtually scrolled)
+    window->DC.CursorPos.y = heights ? Rows->StartPos.y + heights->GetTotalHeight() : window->DC.CursorStartPos.y + ComboVirtualScroll::MaxPhysicalHeight;
+    window->DC.CursorMaxPos.y = ImMax(window->DC.CursorMaxPos.y, window->DC.CursorPos.y);
+    DisplayStart = DisplayEnd = RowCount;
+    return false;
+}
+
+ComboItemWidthCache* GetComboItemWidthCache(const void* items_source)
+{
+    ImGuiContext& g = *GImGui;
+    ComboItemWidthCache& cache = gComboItemWidthCaches[items_source];
+    if (cache.Font != g.Font || cache.FontSize != g.FontSize) {
+        cache.Reset();
+        cache.Font = g.Font;
+        cache.FontSize = g.FontSize;
+    }
+    cache.LastUsedFrame = g.FrameCount;
+    return &cache;
+}
+
+ComboItemWidthCache* FindComboItemWidthCache(const void* items_source)
+{
+    ImGuiContext& g = *GImGui;
+    auto it = gComboItemWidthCaches.find(items_source);
+    if (it == gComboItemWidthCaches.end() || it->second.Font != g.Font || it->second.FontSize != g.FontSize)
+        return NULL;
+    return &it->second;
+}
+
+float CalcComboAutoPopupWidth(float min_width, float max_item_width)
+{
+    // The rows are inset by the window padding, the list box frame padding and half the item spacing, and leave room for the scrollbar
+    const ImGuiStyle& style = GImGui->Style;
+    const float width = max_item_width + style.WindowPadding.x * 2.0f + style.FramePadding.x * 2.0f + style.ItemSpacing.x + style.ScrollbarSize;
+    return ImMax(min_width, ImMin(width, GetMainViewport()->WorkSize.x));
+}
+
+void RenderComboPreview(const ImRect& bb, const char* preview, float preview_width)
+{
+    if (preview_width > bb.GetWidth()) {
+        const ImVec2 preview_size(preview_width, GImGui->FontSize);
+        RenderTextEllipsis(GImGui->CurrentWindow->DrawList, bb.Min, bb.Max, bb.Max.x, bb.Max.x, preview, NULL, &preview_size);
+    }
+    else {
+        RenderTextClipped(bb.Min, bb.Max, preview, NULL, NULL, ImVec2(0.0f, 0.0f));
+    }
+}
+
+ComboItemSource* AddComboItemSource(const char* name)
+{
+    const ImGuiID id = ImHashStr(name);
+    auto [it, inserted] = gComboItemSources.try_emplace(id, std::make_unique<ComboItemSource>());
+    IM_ASSERT(inserted && "An item source is already registered with this name!");
+    it->second->ID = id;
+    return it->second.get();
+}
+
+void OnComboItemSourceChanged(ComboItemSource& source)
+{
+    ++source.Version;
+    ClearComboItemWidthCache(&source);
+    ClearComboResultCache(&source);
+}
+
+static ImGuiID CalcComboResultCacheKey(const void* items_source, int items_version, ImGuiID engine_id, const char* query)
+{
+    struct
+    {
+        const void* ItemsSource;
+        int         ItemsVersion;
+        ImGuiID     EngineID;
+    } key;
+    memset(&key, 0, sizeof(key)); // Padding is hashed too
+    key.ItemsSource = items_source;
+    key.ItemsVersion = items_version;
+    key.EngineID = engine_id;
+    return ImHashStr(query, 0, ImHashData(&key, sizeof(key)));
+}
+
+static void EraseComboCachedResults(ComboResultCacheList::iterator it)
+{
+    gComboResultCacheBytes -= it->CalcMemoryUsage();
+    gComboResultCacheLookup.erase(it->Key);
+    gComboResultCache.erase(it);
+}
+
+bool FindComboCachedResults(const void* items_source, int items_version, ImGuiID engine_id, const char* query, ComboFilterSearchResults& out_results, ComboFilterRanking& out_ranking)
+{
+    auto lookup_it = gComboResultCacheLookup.find(CalcComboResultCacheKey(items_source, items_version, engine_id, query));
+    if (lookup_it == gComboResultCacheLookup.end())
+        return false;
+    const ComboResultCacheList::iterator it = lookup_it->second;
+    if (it->ItemsSource != items_source || it->ItemsVersion != items_version || it->EngineID != engine_id || strcmp(it->Query.Data, query) != 0)
+        return false; // Hash collision
+    gComboResultCache.splice(gComboResultCache.begin(), gComboResultCache, it);
+    out_results = it->Results;
+    out_ranking = it->Ranking;
+    return true;
+}
+
+void AddComboCachedResults(const void* items_source, int items_version, ImGuiID engine_id, const char* query, const ComboFilterSearchResults& results, const ComboFilterRanking& ranking)
+{
+    const ImGuiID key = CalcComboResultCacheKey(items_source, items_version, engine_id, query);
+    auto lookup_it = gComboResultCacheLookup.find(key);
+    if (lookup_it != gComboResultCacheLookup.end())
+        EraseComboCachedResults(lookup_it->second);
+
+    ComboResultCacheEntry& entry = gComboResultCache.emplace_front();
+    entry.Key = key;
+    entry.ItemsSource = items_source;
+    entry.ItemsVersion = items_version;
+    entry.EngineID = engine_id;
+    entry.Query.resize(static_cast<int>(strlen(query)) + 1);
+    memcpy(entry.Query.Data, query, entry.Query.Size);
+    entry.Results = results;
+    entry.Ranking = ranking;
+    gComboResultCacheLookup[key] = gComboResultCache.begin();
+    gComboResultCacheBytes += entry.CalcMemoryUsage();
+
+    // Evicting the least recently used results, possibly the new ones if they alone exceed the budget
+    while (gComboResultCacheBytes > gComboResultCacheBudget)
+        EraseComboCachedResults(std::prev(gComboResultCache.end()));
+}
+
+ImU64 CalcComboItemSignature(const char* folded_text)
+{
+    ImU64 signature = 0;
+    for (; *folded_text != '\0'; ++folded_text) {
+        const unsigned char c = static_cast<unsigned char>(*folded_text);
+        const int bit = (c >= 'a' && c <= 'z') ? c - 'a' : (c >= '0' && c <= '9') ? 26 + c - '0' : 36 + c % 28;
+        signature |= static_cast<ImU64>(1) << bit;
+    }
+    return signature;
+}
+
+}
+
+const char* ComboItemSource::GetItem(int index) const
+{
+    if (index < 0 || index >= Count)
+        return "";
+    if (Storage == ComboItemSourceStorage_Dafsa)
+        return Dafsa.GetItem(index);
+    return Storage == ComboItemSourceStorage_Owned ? OwnedTexts.Data + OwnedOffsets[index] : BorrowedThunk(*this, index);
+}
+
+void ComboItemSource::BuildIndexes() const
+{
+    IM_ASSERT(Storage != ComboItemSourceStorage_Dafsa && "The search indexes would hold every decoded text of a DAFSA source");
+    if (IndexesVersion == Version)
+        return;
+
+    // Folded with tolower() like FuzzySearchEX compares characters, so a folded item is a subsequence of the folded query whenever FuzzySearchEX can match them
+    FoldedTexts.resize(0);
+    if (Storage == ComboItemSourceStorage_Owned)
+        FoldedTexts.reserve(OwnedTexts.Size);
+    FoldedOffsets.resize(Count);
+    MinItemLength = Count > 0 ? INT_MAX : 0;
+    MaxItemLength = 0;
+    HasWordBoundaries = false;
+    for (int i = 0; i < Count; ++i) {
+        FoldedOffsets[i] = FoldedTexts.Size;
+        const char* item = GetItem(i);
+        const char* text = item;
+        for (; *text != '\0'; ++text) {
+            FoldedTexts.push_back(static_cast<char>(tolower(*text)));
+            if (text > item && ((::islower(text[-1]) && ::isupper(*text)) || text[-1] == '_' || text[-1] == ' '))
+                HasWordBoundaries = true;
+        }
+        FoldedTexts.push_back('\0');
+        MinItemLength = ImMin(MinItemLength, static_cast<int>(text - item));
+        MaxItemLength = ImMax(MaxItemLength, static_cast<int>(text - item));
+    }
+    Signatures.resize(Count);
+    for (int i = 0; i < Count; ++i)
+        Signatures[i] = Internal::CalcComboItemSignature(GetFoldedItem(i));
+    IndexesVersion = Version;
+}
+
+void ComboItemSource::BuildPrefixIndex() const
+{
+    BuildIndexes();
+    if (PrefixIndexVersion == Version)
+        return;
+
+    SortedOrder.resize(Count);
+    for (int i = 0; i < Count; ++i)
+        SortedOrder[i] = i;
+    std::sort(SortedOrder.begin(), SortedOrder.end(), [this](int lhs, int rhs) {
+        const int cmp = strcmp(GetFoldedItem(lhs), GetFoldedItem(rhs));
+        return cmp < 0 || (cmp == 0 && lhs < rhs);
+    });
+    PrefixIndexVersion = Version;
+}
+
+void ComboItemSource::FindPrefixRange(const char* folded_prefix, int& out_begin, int& out_end) const
+{
+    IM_ASSERT(PrefixIndexVersion == Version && "BuildPrefixIndex() has to be called first");
+    // The items starting with the prefix are the ones comparing equal to it on its length, and are contiguous in the sorted order
+    const size_t prefix_length = strlen(folded_prefix);
+    const int* sorted_begin = SortedOrder.begin();
+    const int* sorted_end = SortedOrder.end();
+    const int* begin = std::lower_bound(sorted_begin, sorted_end, folded_prefix, [this, prefix_length](int index, const char* prefix) {
+        return strncmp(GetFoldedItem(index), prefix, prefix_length) < 0;
+    });
+    const int* end = std::upper_bound(begin, sorted_end, folded_prefix, [this, prefix_length](const char* prefix, int index) {
+        return strncmp(prefix, GetFoldedItem(index), prefix_length) < 0;
+    });
+    out_begin = static_cast<int>(begin - sorted_begin);
+    out_end = static_cast<int>(end - sorted_begin);
+}
+
+void ComboItemSource::BuildSuffixIndex() const
+{
+    BuildIndexes();
+    if (SuffixIndexVersion == Version)
+        return;
+
+    const auto t0 = std::chrono::steady_clock::now();
+
+    // Every suffix ends with its item, the items being zero terminated. Equal suffixes are sorted by offset, and so by item
+    // Sorted on their first 8 bytes packed in an integer first, then with strcmp() past them within the runs of suffixes sharing them
+    struct KeyedSuffix
+    {
+        ImU64 Key;
+        int   Offset;
+        int   Item;
+        bool operator<(const KeyedSuffix& rhs) const { return Key < rhs.Key || (Key == rhs.Key && Offset < rhs.Offset); }
+    };
+    const char* texts = FoldedTexts.Data;
+    std::vector<KeyedSuffix> suffixes;
+    suffixes.reserve(FoldedTexts.Size - Count);
+    for (int i = 0; i < Count; ++i) {
+        for (int offset = FoldedOffsets[i]; texts[offset] != '\0'; ++offset) {
+            ImU64 key = 0;
+            int byte = 0;
+            for (; byte < 8 && texts[offset + byte] != '\0'; ++byte)
+                key = (key << 8) | static_cast<unsigned char>(texts[offset + byte]);
+            suffixes.push_back({ key << (8 * (8 - byte)), offset, i });
+        }
+    }
+    std::sort(suffixes.begin(), suffixes.end());
+    for (size_t run_begin = 0; run_begin < suffixes.size();) {
+        size_t run_end = run_begin + 1;
+        while (run_end < suffixes.size() && suffixes[run_end].Key == suffixes[run_begin].Key)
+            ++run_end;
+        // Suffixes shorter than 8 bytes are equal, and already sorted by offset
+        if (run_end - run_begin > 1 && (suffixes[run_begin].Key & 0xFF) != 0) {
+            std::sort(suffixes.begin() + run_begin, suffixes.begin() + run_end, [texts](const KeyedSuffix& lhs, const KeyedSuffix& rhs) {
+                const int cmp = strcmp(texts + lhs.Offset + 8, texts + rhs.Offset + 8);
+                return cmp < 0 || (cmp == 0 && lhs.Offset < rhs.Offset);
+            });
+        }
+        run_begin = run_end;
+    }
+
+    SuffixArray.resize(static_cast<int>(suffixes.size()));
+    SuffixItems.resize(static_cast<int>(suffixes.size()));
+    for (int i = 0; i < SuffixArray.Size; ++i) {
+        SuffixArray[i] = suffixes[i].Offset;
+        SuffixItems[i] = suffixes[i].Item;
+    }
+
+    SuffixIndexVersion = Version;
+    SuffixIndexBuildTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+}
+
+void ComboItemSource::FindSubstringRange(const char* folded_query, int& out_begin, int& out_end) const
+{
+    IM_ASSERT(SuffixIndexVersion == Version && "BuildSuffixIndex() has to be called first");
+    // Same search as FindPrefixRange(), over the suffixes: an item contains the query when one of its suffixes starts with it
+    const size_t query_length = strlen(folded_query);
+    const char* texts = FoldedTexts.Data;
+    const int* sorted_begin = SuffixArray.begin();
+    const int* sorted_end = SuffixArray.end();
+    const int* begin = std::lower_bound(sorted_begin, sorted_end, folded_query, [texts, query_length](int offset, const char* query) {
+        return strncmp(texts + offset, query, query_length) < 0;
+    });
+    const int* end = std::upper_bound(begin, sorted_end, folded_query, [texts, query_length](const char* query, int offset) {
+        return strncmp(query, texts + offset, query_length) < 0;
+    });
+    out_begin = static_cast<int>(begin - sorted_begin);
+    out_end = static_cast<int>(end - sorted_begin);
+}
+
+size_t ComboItemSource::CalcMemoryUsage() const
+{
+    return sizeof(*this) + OwnedTexts.Capacity + OwnedOffsets.Capacity * sizeof(int) + FoldedTexts.Capacity + FoldedOffsets.Capacity * sizeof(int) + Signatures.Capacity * sizeof(ImU64)
+        + SortedOrder.Capacity * sizeof(int) + SuffixArray.Capacity * sizeof(int) + SuffixItems.Capacity * sizeof(int) + Dafsa.CalcMemoryUsage() - sizeof(Dafsa);
+}
+
+namespace Internal
+{
+
+// Automaton of a ComboDafsa being built, one entry per state and per edge, before it is stored into ComboDafsa::Nodes
+struct ComboDafsaBuilder
+{
+    struct State
+    {
+        ImU32 FirstEdge;
+        ImU32 WordCount;
+        ImU32 EdgeCount;
+        bool  Final;
+    };
+
+    ImVector<State> States;
+    ImVector<char>  EdgeLabels;
+    ImVector<ImU32> EdgeTargets;
+};
+
+// State of the last word added to a ComboDafsa being built, its last edge leads to the next state of the word until it is frozen
+struct ComboDafsaPathState
+{
+    ImVector<char>  Labels;
+    ImVector<ImU32> Targets;
+    bool            Final{ false };
+};
+
+static ImU64 HashComboDafsaState(const ComboDafsaPathState& state)
+{
+    ImU64 hash = state.Final ? 0x9E3779B97F4A7C15ull : 0;
+    for (int i = 0; i < state.Labels.Size; ++i) {
+        hash = (hash ^ static_cast<unsigned char>(state.Labels[i])) * 0x100000001B3ull;
+        hash = (hash ^ state.Targets[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+template<typename T>
+static void ShrinkComboDafsaVector(ImVector<T>& vector)
+{
+    ImVector<T> shrunk;
+    shrunk.reserve(vector.Size);
+    shrunk.resize(vector.Size);
+    if (vector.Size > 0)
+        memcpy(shrunk.Data, vector.Data, vector.size_in_bytes());
+    vector.swap(shrunk);
+}
+
+static bool IsSameComboDafsaState(const ComboDafsaBuilder& builder, ImU32 frozen, const ComboDafsaPathState& state)
+{
+    const ComboDafsaBuilder::State& other = builder.States[frozen];
+    return other.Final == state.Final && other.EdgeCount == static_cast<ImU32>(state.Labels.Size)
+        && memcmp(builder.EdgeLabels.Data + other.FirstEdge, state.Labels.Data, state.Labels.Size) == 0
+        && memcmp(builder.EdgeTargets.Data + other.FirstEdge, state.Targets.Data, state.Targets.Size * sizeof(ImU32)) == 0;
+}
+
+// Returns the state equivalent to 'state' (same finality and edges), adding it if there is none
+// The states are frozen children first, so the edges of a state only lead to frozen states
+static ImU32 FreezeComboDafsaState(ComboDafsaBuilder& builder, std::unordered_map<ImU64, ImU32>& frozen_states, const ComboDafsaPathState& state)
+{
+    const ImU64 hash = HashComboDafsaState(state);
+    auto it = frozen_states.find(hash);
+    if (it != frozen_states.end() && IsSameComboDafsaState(builder, it->second, state))
+        return it->second;
+
+    ComboDafsaBuilder::State frozen{ static_cast<ImU32>(builder.EdgeLabels.Size), state.Final ? 1u : 0u, static_cast<ImU32>(state.Labels.Size), state.Final };
+    for (int i = 0; i < state.Labels.Size; ++i) {
+        builder.EdgeLabels.push_back(state.Labels[i]);
+        builder.EdgeTargets.push_back(state.Targets[i]);
+        frozen.WordCount += builder.States[state.Targets[i]].WordCount;
+    }
+    const ImU32 index = static_cast<ImU32>(builder.States.Size);
+    builder.States.push_back(frozen);
+    if (it == frozen_states.end())
+        frozen_states.emplace(hash, index); // A hash collision only leaves an equivalent state unshared
+    return index;
+}
+
+static void WriteComboDafsaVarint(ImVector<unsigned char>& nodes, ImU32 value)
+{
+    for (; value >= 0x80; value >>= 7)
+        nodes.push_back(static_cast<unsigned char>(value | 0x80));
+    nodes.push_back(static_cast<unsigned char>(value));
+}
+
+static ImU32 ReadComboDafsaVarint(const unsigned char*& p)
+{
+    ImU32 value = 0;
+    for (int shift = 0;; shift += 7) {
+        const unsigned char byte = *p++;
+        value |= static_cast<ImU32>(byte & 0x7F) << shift;
+        if (!(byte & 0x80))
+            return value;
+    }
+}
+
+// Stores the built states into 'dafsa.Nodes', in the order they were frozen (children first)
+static void StoreComboDafsaStates(const ComboDafsaBuilder& builder, ImU32 root, ComboDafsa& dafsa)
+{
+    ImVector<ImU32> in_degree;
+    in_degree.resize(builder.States.Size, 0);
+    for (ImU32 target : builder.EdgeTargets)
+        ++in_degree[target];
+    auto is_chained = [&](ImU32 state) {
+        const ComboDafsaBuilder::State& s = builder.States[state];
+        return state != root && !s.Final && s.EdgeCount == 1 && in_degree[state] == 1;
+    };
+
+    ImVector<ImU32> offsets;
+    offsets.resize(builder.States.Size, 0);
+    for (ImU32 state = 0; state < static_cast<ImU32>(builder.States.Size); ++state) {
+        if (is_chained(state))
+            continue;
+        const ComboDafsaBuilder::State& s = builder.States[state];
+        offsets[state] = static_cast<ImU32>(dafsa.Nodes.Size);
+        WriteComboDafsaVarint(dafsa.Nodes, s.WordCount);
+        WriteComboDafsaVarint(dafsa.Nodes, (s.EdgeCount << 1) | (s.Final ? 1u : 0u));
+        for (ImU32 edge = s.FirstEdge; edge < s.FirstEdge + s.EdgeCount; ++edge) {
+            // The chained states following the edge become more of its labels
+            ImU32 label_count = 1;
+            ImU32 target = builder.EdgeTargets[edge];
+            for (; is_chained(target); target = builder.EdgeTargets[builder.States[target].FirstEdge])
+                ++label_count;
+            WriteComboDafsaVarint(dafsa.Nodes, label_count);
+            dafsa.Nodes.push_back(static_cast<unsigned char>(builder.EdgeLabels[edge]));
+            for (ImU32 chained = builder.EdgeTargets[edge]; chained != target; chained = builder.EdgeTargets[builder.States[chained].FirstEdge])
+                dafsa.Nodes.push_back(static_cast<unsigned char>(builder.EdgeLabels[builder.States[chained].FirstEdge]));
+            WriteComboDafsaVarint(dafsa.Nodes, static_cast<ImU32>(dafsa.Nodes.Size) - offsets[target]);
+        }
+        ++dafsa.StateCount;
+    }
+    dafsa.Root = offsets[root];
+}
+
+// Edge of a stored state, read from 'p' which is moved past it
+struct ComboDafsaEdge
+{
+    const unsigned char* Labels;
+    ImU32                LabelCount;
+    ImU32                Target;
+};
+
+static ComboDafsaEdge ReadComboDafsaEdge(const ComboDafsa& dafsa, const unsigned char*& p)
+{
+    ComboDafsaEdge edge;
+    edge.LabelCount = ReadComboDafsaVarint(p);
+    edge.Labels = p;
+    p += edge.LabelCount;
+    const ImU32 distance_offset = static_cast<ImU32>(p - dafsa.Nodes.Data);
+    edge.Target = distance_offset - ReadComboDafsaVarint(p);
+    return edge;
+}
+
+static ImU32 GetComboDafsaWordCount(const ComboDafsa& dafsa, ImU32 state)
+{
+    const unsigned char* p = dafsa.Nodes.Data + state;
+    return ReadComboDafsaVarint(p);
+}
+
+// Position in a ComboDafsa: a state, or the next label of an edge with 'Left' labels to go
+struct ComboDafsaCursor
+{
+    ImU32 Pos;
+    ImU32 Left;
+};
+
+// Words accepted from the cursor, those of the state ending its edge when it is on one
+static ImU32 GetComboDafsaCursorWordCount(const ComboDafsa& dafsa, const ComboDafsaCursor& cursor)
+{
+    if (cursor.Left == 0)
+        return GetComboDafsaWordCount(dafsa, cursor.Pos);
+    const unsigned char* p = dafsa.Nodes.Data + cursor.Pos + cursor.Left;
+    const ImU32 distance_offset = static_cast<ImU32>(p - dafsa.Nodes.Data);
+    return GetComboDafsaWordCount(dafsa, distance_offset - ReadComboDafsaVarint(p));
+}
+
+static bool IsComboDafsaCursorFinal(const ComboDafsa& dafsa, const ComboDafsaCursor& cursor)
+{
+    if (cursor.Left > 0)
+        return false;
+    const unsigned char* p = dafsa.Nodes.Data + cursor.Pos;
+    ReadComboDafsaVarint(p);
+    return (ReadComboDafsaVarint(p) & 1) != 0;
+}
+
+}
+
+void ComboDafsa::Build(const char* texts, const int* offsets, int count)
+{
+    Clear();
+    ItemCount = count;
+    RawTextSize = static_cast<size_t>(count) * sizeof(int);
+    for (int i = 0; i < count; ++i)
+        RawTextSize += strlen(texts + offsets[i]) + 1;
+
+    // Incremental construction over the sorted texts (Daciuk et al.): the states of the previous word past the prefix it shares with
+    // the next one can no longer change, they are frozen and merged with an equivalent frozen state if there is one
+    ImVector<int> order;
+    order.resize(count);
+    for (int i = 0; i < count; ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [texts, offsets](int lhs, int rhs) {
+        const int cmp = strcmp(texts + offsets[lhs], texts + offsets[rhs]);
+        return cmp < 0 || (cmp == 0 && lhs < rhs);
+    });
+
+    Internal::ComboDafsaBuilder builder;
+    std::unordered_map<ImU64, ImU32> frozen_states;
+    std::vector<Internal::ComboDafsaPathState> path(1);
+    int path_length = 0;
+    auto freeze_path = [&](int length) {
+        for (; path_length > length; --path_length) {
+            Internal::ComboDafsaPathState& state = path[path_length];
+            path[path_length - 1].Targets.back() = Internal::FreezeComboDafsaState(builder, frozen_states, state);
+            state.Labels.resize(0);
+            state.Targets.resize(0);
+            state.Final = false;
+        }
+    };
+
+    const char* prev_text = NULL;
+    ImVector<int> item_ranks;
+    ImVector<int> rank_items;
+    item_ranks.resize(count);
+    bool identity = true;
+    for (int i = 0; i < count; ++i) {
+        const int item = order[i];
+        const char* text = texts + offsets[item];
+        if (prev_text != NULL && strcmp(prev_text, text) == 0) {
+            item_ranks[item] = WordCount - 1;
+            identity = false;
+            continue;
+        }
+        int common = 0;
+        if (prev_text != NULL)
+            while (prev_text[common] != '\0' && prev_text[common] == text[common])
+                ++common;
+        freeze_path(common);
+
+        const int length = static_cast<int>(strlen(text));
+        if (static_cast<int>(path.size()) <= length)
+            path.resize(length + 1);
+        for (; path_length < length; ++path_length) {
+            path[path_length].Labels.push_back(text[path_length]);
+            path[path_length].Targets.push_back(0);
+        }
+        path[length].Final = true;
+
+        identity &= item == WordCount;
+        item_ranks[item] = WordCount;
+        rank_items.push_back(item);
+        ++WordCount;
+        prev_text = text;
+    }
+    freeze_path(0);
+    const ImU32 root = Internal::FreezeComboDafsaState(builder, frozen_states, path[0]);
+    Internal::StoreComboDafsaStates(builder, root, *this);
+
+    if (!identity) {
+        ItemRanks.swap(item_ranks);
+        RankItems.swap(rank_items);
+    }
+    Internal::ShrinkComboDafsaVector(Nodes);
+    Internal::ShrinkComboDafsaVector(ItemRanks);
+    Internal::ShrinkComboDafsaVector(RankItems);
+}
+
+void ComboDafsa::Clear()
+{
+    Nodes.clear();
+    Root = 0;
+    StateCount = 0;
+    ItemRanks.clear();
+    RankItems.clear();
+    ItemCount = 0;
+    WordCount = 0;
+    RawTextSize = 0;
+}
+
+const char* ComboDafsa::GetItem(int index) const
+{
+    if (index < 0 || index >= ItemCount)
+        return "";
+    ImVector<char>& buffer = DecodeBuffers[DecodeBufferIndex];
+    DecodeBufferIndex = (DecodeBufferIndex + 1) % DecodeBufferCount;
+    GetWord(GetItemRank(index), buffer);
+    return buffer.Data;
+}
+
+void ComboDafsa::GetWord(int rank, ImVector<char>& out_text) const
+{
+    IM_ASSERT(rank >= 0 && rank < WordCount);
+    out_text.resize(0);
+    ImU32 rest = static_cast<ImU32>(rank);
+    ImU32 state = Root;
+    for (;;) {
+        const unsigned char* p = Nodes.Data + state;
+        Internal::ReadComboDafsaVarint(p); // Word count
+        const ImU32 header = Internal::ReadComboDafsaVarint(p);
+        if (header & 1) {
+            if (rest == 0)
+                break;
+            --rest;
+        }
+        Internal::ComboDafsaEdge edge;
+        for (ImU32 edge_count = header >> 1;; --edge_count) {
+            IM_ASSERT(edge_count > 0);
+            edge = Internal::ReadComboDafsaEdge(*this, p);
+            const ImU32 word_count = Internal::GetComboDafsaWordCount(*this, edge.Target);
+            if (rest < word_count)
+                break;
+            rest -= word_count;
+        }
+        for (ImU32 i = 0; i < edge.LabelCount; ++i)
+            out_text.push_back(static_cast<char>(edge.Labels[i]));
+        state = edge.Target;
+    }
+    out_text.push_back('\0');
+}
+
+namespace Internal
+{
+
+// Follows the label 'c' from the cursor, adding the words of the edges skipped on the way to 'rank'
+static bool FollowComboDafsaEdge(const ComboDafsa& dafsa, ComboDafsaCursor& cursor, ImU32& rank, char c)
+{
+    const unsigned char label = static_cast<unsigned char>(c);
+    const unsigned char* p = dafsa.Nodes.Data + cursor.Pos;
+    if (cursor.Left > 0) {
+        if (*p++ != label)
+            return false;
+        if (--cursor.Left > 0) {
+            ++cursor.Pos;
+            return true;
+        }
+        const ImU32 distance_offset = static_cast<ImU32>(p - dafsa.Nodes.Data);
+        cursor.Pos = distance_offset - ReadComboDafsaVarint(p);
+        return true;
+    }
+
+    ReadComboDafsaVarint(p); // Word count
+    const ImU32 header = ReadComboDafsaVarint(p);
+    ImU32 skipped = header & 1;
+    for (ImU32 edge_index = 0; edge_index < header >> 1; ++edge_index) {
+        const ComboDafsaEdge edge = ReadComboDafsaEdge(dafsa, p);
+        if (edge.Labels[0] == label) {
+            rank += skipped;
+            if (edge.LabelCount == 1)
+                cursor = { edge.Target, 0 };
+            else
+                cursor = { static_cast<ImU32>(edge.Labels + 1 - dafsa.Nodes.Data), edge.LabelCount - 1 };
+            return true;
+        }
+        skipped += GetComboDafsaWordCount(dafsa, edge.Target);
+    }
+    return false;
+}
+
+// Position reached by spelling the prefix, with the rank of the first word starting with it
+static bool FindComboDafsaPrefixState(const ComboDafsa& dafsa, const char* prefix, ComboDafsaCursor& out_cursor, ImU32& out_rank)
+{
+    out_cursor = { dafsa.Root, 0 };
+    out_rank = 0;
+    if (dafsa.Nodes.Size == 0)
+        return false;
+    for (const char* c = prefix; *c != '\0'; ++c)
+        if (!FollowComboDafsaEdge(dafsa, out_cursor, out_rank, *c))
+            return false;
+    return true;
+}
+
+}
+
+int ComboDafsa::FindWord(const char* text) const
+{
+    // The text comes first among the words it prefixes, when it is a word itself
+    Internal::ComboDafsaCursor cursor;
+    ImU32 rank;
+    if (!Internal::FindComboDafsaPrefixState(*this, text, cursor, rank) || !Internal::IsComboDafsaCursorFinal(*this, cursor))
+        return -1;
+    return static_cast<int>(rank);
+}
+
+bool ComboDafsa::FindPrefix(const char* prefix, int& out_rank_begin, int& out_rank_end) const
+{
+    Internal::ComboDafsaCursor cursor;
+    ImU32 rank;
+    if (!Internal::FindComboDafsaPrefixState(*this, prefix, cursor, rank)) {
+        out_rank_begin = out_rank_end = 0;
+        return false;
+    }
+    out_rank_begin = static_cast<int>(rank);
+    out_rank_end = static_cast<int>(rank + Internal::GetComboDafsaCursorWordCount(*this, cursor));
+    return out_rank_begin < out_rank_end;
+}
+
+int ComboDafsa::FindFirstWordWithPrefixIgnoreCase(const char* prefix) const
+{
+    if (Nodes.Size == 0)
+        return -1;
+
+    // Every path spelling the prefix in some case, only the cases present in the items are followed
+    // Paths reaching the same position are merged, keeping the lowest rank
+    ImVector<Internal::ComboDafsaCursor> cursors, next_cursors;
+    ImVector<ImU32> ranks, next_ranks;
+    cursors.push_back({ Root, 0 });
+    ranks.push_back(0);
+    auto add_next = [&](const Internal::ComboDafsaCursor& cursor, ImU32 rank) {
+        for (int i = 0; i < next_cursors.Size; ++i) {
+            if (next_cursors[i].Pos == cursor.Pos) {
+                if (rank < next_ranks[i])
+                    next_ranks[i] = rank;
+                return;
+            }
+        }
+        next_cursors.push_back(cursor);
+        next_ranks.push_back(rank);
+    };
+    for (const char* c = prefix; *c != '\0' && cursors.Size > 0; ++c) {
+        const char lower = static_cast<char>(tolower(*c));
+        const char upper = static_cast<char>(toupper(*c));
+        next_cursors.resize(0);
+        next_ranks.resize(0);
+        for (int i = 0; i < cursors.Size; ++i) {
+            Internal::ComboDafsaCursor cursor = cursors[i];
+            ImU32 rank = ranks[i];
+            if (Internal::FollowComboDafsaEdge(*this, cursor, rank, lower))
+                add_next(cursor, rank);
+            cursor = cursors[i];
+            rank = ranks[i];
+            if (upper != lower && Internal::FollowComboDafsaEdge(*this, cursor, rank, upper))
+                add_next(cursor, rank);
+        }
+        cursors.swap(next_cursors);
+        ranks.swap(next_ranks);
+    }
+
+    int first_rank = -1;
+    for (int i = 0; i < cursors.Size; ++i)
+        if (Internal::GetComboDafsaCursorWordCount(*this, cursors[i]) > 0 && (first_rank < 0 || static_cast<int>(ranks[i]) < first_rank))
+            first_rank = static_cast<int>(ranks[i]);
+    return first_rank;
+}
+
+size_t ComboDafsa::CalcMemoryUsage() const
+{
+    size_t bytes = sizeof(*this) + Nodes.Capacity + ItemRanks.Capacity * sizeof(int) + RankItems.Capacity * sizeof(int);
+    for (const ImVector<char>& buffer : DecodeBuffers)
+        bytes += buffer.Capacity;
+    return bytes;
+}
+
+namespace Internal
+{
+
+// Filters out the items of a source that cannot match a query, before the far more expensive FuzzySearchEX
+// Disabled for item getters other than GetComboItemSourceItem(), as the indexes are built from the source items, and for DAFSA sources
+struct ComboItemSourcePrefilter
+{
+    const ComboItemSource& Source;
+    ImVector<char>         FoldedQuery;
+    ImU64                  QuerySignature{ 0 };
+    bool                   Enabled;
+
+    ComboItemSourcePrefilter(const ComboItemSource& source, const char* query, ComboItemGetterCallback<const ComboItemSource&> item_getter) : Source(source), Enabled(item_getter == GetComboItemSourceItem && source.Storage != ComboItemSourceStorage_Dafsa)
+    {
+        if (!Enabled)
+            return;
+        Source.BuildIndexes();
+        for (; *query != '\0'; ++query)
+            FoldedQuery.push_back(static_cast<char>(tolower(*query)));
+        FoldedQuery.push_back('\0');
+        QuerySignature = CalcComboItemSignature(FoldedQuery.Data);
+    }
+
+    bool MayMatch(int index) const
+    {
+        if (!Enabled)
+            return true;
+        if (QuerySignature & ~Source.Signatures[index])
+            return false;
+        const char* query = FoldedQuery.Data;
+        for (const char* text = Source.GetFoldedItem(index); *query != '\0' && *text != '\0'; ++text)
+            query += *query == *text;
+        return *query == '\0';
+    }
+};
+
+template<>
+int DefaultComboAutoSelectSearchCallback<const ComboItemSource&>(const ComboAutoSelectSearchCallbackData<const ComboItemSource&>& callback_data)
+{
+    if (callback_data.SearchString[0] == '\0')
+        return -1;
+
+    const ComboItemSourcePrefilter prefilter(callback_data.Items, callback_data.SearchString, callback_data.ItemGetter);
+    const int item_count = callback_data.Items.size();
+    const ComboItemSource& source = callback_data.Items;
+    const int score_ceiling = prefilter.Enabled ? FuzzySearchScoreCeiling(callback_data.SearchString, source.MinItemLength, source.MaxItemLength, source.HasWordBoundaries) : FuzzySearchScoreCeiling(callback_data.SearchString);
+    constexpr int max_matches = 128;
+    unsigned char matches[max_matches];
+    int best_item = -1;
+    int match_count;
+    int best_score = 0;
+    int upper_bound;
+    int score;
+
+    // Same branch and bound as the generic callback, over the items left by the prefilter
+    // The ceiling is bounded by the lengths and word boundaries of the items, found when the indexes were built
+    for (int i = 0; i < item_count; ++i) {
+        if (!prefilter.MayMatch(i))
+            continue;
+        const char* item_text = callback_data.ItemGetter(callback_data.Items, i);
+        if (!FuzzySearchScoreUpperBound(callback_data.SearchString, item_text, max_matches, upper_bound) || (best_item >= 0 && upper_bound <= best_score))
+            continue;
+        if (!FuzzySearchEX(callback_data.SearchString, item_text, score, matches, max_matches, match_count) || (best_item >= 0 && score <= best_score))
+            continue;
+        best_score = score;
+        best_item = i;
+        if (best_score >= score_ceiling)
+            break;
+    }
+
+    return best_item;
+}
+
+int PrefixComboAutoSelectSearchCallback(const ComboAutoSelectSearchCallbackData<const ComboItemSource&>& callback_data)
+{
+    // The prefix index is built from the source items, other item getters get the fuzzy search
+    if (callback_data.SearchString[0] == '\0' || callback_data.ItemGetter != GetComboItemSourceItem)
+        return DefaultComboAutoSelectSearchCallback(callback_data);
+
+    ImVector<char> folded_query;
+    for (const char* query = callback_data.SearchString; *query != '\0'; ++query)
+        folded_query.push_back(static_cast<char>(tolower(*query)));
+    folded_query.push_back('\0');
+
+    const ComboItemSource& source = callback_data.Items;
+    if (source.Storage == ComboItemSourceStorage_Dafsa) {
+        // Byte order instead of case-folded order, the automaton holds the texts as they are
+        const int rank = source.Dafsa.FindFirstWordWithPrefixIgnoreCase(callback_data.SearchString);
+        return rank >= 0 ? source.Dafsa.GetRankItem(rank) : DefaultComboAutoSelectSearchCallback(callback_data);
+    }
+    source.BuildPrefixIndex();
+    int range_begin, range_end;
+    source.FindPrefixRange(folded_query.Data, range_begin, range_end);
+    if (range_begin == range_end)
+        return DefaultComboAutoSelectSearchCallback(callback_data);
+    return source.SortedOrder[range_begin];
+}
+
+static int CalcComboSubstringScore(const char* item_text, int offset, int query_length)
+{
+    const int item_length = static_cast<int>(strlen(item_text));
+    int score = 100 - 2 * offset - (item_length - query_length);
+    if (offset == 0 || item_text[offset - 1] == '_' || item_text[offset - 1] == ' ')
+        score += 30;
+    return score;
+}
+
+// Offset of the first occurrence of the folded query in the text, ignoring case, -1 if there is none
+static int FindComboSubstring(const char* text, const char* folded_query)
+{
+    for (const char* start = text; *start != '\0'; ++start) {
+        const char* t = start;
+        const char* q = folded_query;
+        while (*q != '\0' && *t != '\0' && tolower(*t) == *q) {
+            ++t;
+            ++q;
+        }
+        if (*q == '\0')
+            return static_cast<int>(start - text);
+    }
+    return -1;
+}
+
+void SubstringComboFilterSearchCallback(const ComboFilterSearchCallbackData<const ComboItemSource&>& callback_data)
+{
+    const ComboItemSource& source = callback_data.Items;
+    ImVector<char> folded_query;
+    for (const char* query = callback_data.SearchString; *query != '\0'; ++query)
+        folded_query.push_back(static_cast<char>(tolower(*query)));
+    folded_query.push_back('\0');
+    const int query_length = folded_query.Size - 1;
+
+    // The suffix array is built from the source items, other item getters and DAFSA sources get a linear scan
+    if (callback_data.ItemGetter != GetComboItemSourceItem || source.Storage == ComboItemSourceStorage_Dafsa) {
+        for (int i = 0; i < source.size(); ++i) {
+            const char* item_text = callback_data.ItemGetter(source, i);
+            const int offset = FindComboSubstring(item_text, folded_query.Data);
+            if (offset >= 0)
+                callback_data.FilterResults->emplace_back(i, CalcComboSubstringScore(item_text, offset, query_length));
+        }
+        SortFilterResultsDescending(*callback_data.FilterResults);
+        return;
+    }
+
+    source.BuildSuffixIndex();
+    int range_begin, range_end;
+    source.FindSubstringRange(folded_query.Data, range_begin, range_end);
+
+    // An item contains the query as many times as it has suffixes in the range, only its first occurrence is scored
+    ImVector<ImU64> hits; // Item in the high bits, offset in the low bits, so they sort by item then by offset
+    hits.reserve(range_end - range_begin);
+    for (int i = range_begin; i < range_end; ++i)
+        hits.push_back((static_cast<ImU64>(source.SuffixItems[i]) << 32) | static_cast<ImU32>(source.SuffixArray[i]));
+    std::sort(hits.begin(), hits.end());
+    for (int i = 0; i < hits.Size; ++i) {
+        const int item = static_cast<int>(hits[i] >> 32);
+        if (i > 0 && static_cast<int>(hits[i - 1] >> 32) == item)
+            continue;
+        const int offset = static_cast<int>(static_cast<ImU32>(hits[i])) - source.FoldedOffsets[item];
+        callback_data.FilterResults->emplace_back(item, CalcComboSubstringScore(source.GetFoldedItem(item), offset, query_length));
+    }
+    SortFilterResultsDescending(*callback_data.FilterResults);
+}
+
+template<>
+void DefaultComboFilterSearchCallback<const ComboItemSource&>(const ComboFilterSearchCallbackData<const ComboItemSource&>& callback_data)
+{
+    // Same two phases as the generic callback
+    const ComboItemSourcePrefilter prefilter(callback_data.Items, callback_data.SearchString, callback_data.ItemGetter);
+    const int item_count = callback_data.Items.size();
+    constexpr int max_matches = 128;
+    int upper_bound;
+
+    auto search_item = [&](int i) {
+        if (prefilter.MayMatch(i) && FuzzySearchScoreUpperBound(callback_data.SearchString, callback_data.ItemGetter(callback_data.Items, i), max_matches, upper_bound))
+            callback_data.FilterResults->emplace_back(i, upper_bound);
+    };
+    if (callback_data.PreviousResults) {
+        ImVector<int> candidates;
+        GetComboNarrowedCandidates(*callback_data.PreviousResults, candidates);
+        for (int i : candidates)
+            search_item(i);
+    }
+    else {
+        for (int i = 0; i < item_count; ++i)
+            search_item(i);
+    }
+    SortFilterResultsDescending(*callback_data.FilterResults);
+
+    ComboFilterRanking ranking{ 0, 0 };
+    const int exact_count = callback_data.Ranking ? ComboFilterRanking::InitialExactCount : static_cast<int>(callback_data.FilterResults->size());
+    RefineComboFilterResults(*callback_data.FilterResults, ranking, exact_count, callback_data.SearchString, [&](int index) { return callback_data.ItemGetter(callback_data.Items, index); });
+    if (callback_data.Ranking)
+        *callback_data.Ranking = ranking;
+}
+
+void UpdateInputTextAndCursor(char* buf, int buf_capacity, const char* new_str)
+{
+    strncpy(buf, new_str, buf_capacity);
+
+    ImGuiContext& g = *GImGui;
+    ImGuiInputTextState& intxt_state = g.InputTextState;
+    const char* buf_end = NULL;
+    intxt_state.CurLenW = ImTextStrFromUtf8(intxt_state.TextW.Data, intxt_state.TextW.Size, buf, NULL, &buf_end);
     intxt_state.CurLenA = (int)(buf_end - buf);
     intxt_state.Stb.cursor = intxt_state.Stb.select_end = static_cast<int>(strlen(buf));
 }
@@ -258,6 +2571,178 @@ bool FuzzySearchEX(char const* pattern, char const* haystack, int& out_score)
 	return FuzzySearchEX(pattern, haystack, out_score, matches, sizeof(matches), match_count);
 }
 
+bool FuzzySearchScoreUpperBound(const char* pattern, const char* haystack, int max_matches, int& out_upper_bound)
+{
+    if (*pattern == '\0' || *haystack == '\0')
+        return false;
+    const int pattern_length = static_cast<int>(strlen(pattern));
+    if (pattern_length > max_matches || pattern_length > 256)
+        return false;
+
+    // Both cases of every pattern character, comparing bytes to them instead of calling tolower() on every byte
+    char lower[256], upper[256];
+    for (int k = 0; k < pattern_length; ++k) {
+        lower[k] = static_cast<char>(tolower(pattern[k]));
+        upper[k] = static_cast<char>(toupper(lower[k]));
+    }
+
+    // Earliest position every character of the pattern can be matched at, by a greedy match from the start
+    int first[256];
+    int matched_count = 0;
+    const char* src = haystack;
+    for (; *src != '\0' && matched_count < pattern_length; ++src)
+        if (*src == lower[matched_count] || *src == upper[matched_count])
+            first[matched_count++] = static_cast<int>(src - haystack);
+    if (matched_count < pattern_length)
+        return false;
+    const int length = static_cast<int>(src - haystack + strlen(src));
+    const int leading_penalty = ImMax(-5 * first[0], -15);
+
+    // Past 256 bytes the match positions wrap around in FuzzySearchRecursive(), any position can then get a bonus and the first match no penalty
+    if (length > 256) {
+        out_upper_bound = 100 - (length - pattern_length) + 15 * (pattern_length - 1) + 30 * pattern_length;
+        return true;
+    }
+
+    // Latest position every character can be matched at, by a greedy match from the end
+    int last[256];
+    for (int pos = length - 1, k = pattern_length - 1; k >= 0; --pos)
+        if (haystack[pos] == lower[k] || haystack[pos] == upper[k])
+            last[k--] = pos;
+
+    // Every character gets at most the best bonus of the positions it can be matched at: a first letter, camel case or separator bonus,
+    // and the sequential bonus if the previous character can be matched right before it
+    int bonus = 0;
+    for (int k = 0; k < pattern_length; ++k) {
+        const int max_bonus = k > 0 ? 30 + 15 : 30;
+        int best = 0;
+        for (int pos = first[k]; pos <= last[k] && best < max_bonus; ++pos) {
+            if (haystack[pos] != lower[k] && haystack[pos] != upper[k])
+                continue;
+            int position_bonus = 15; // First letter
+            if (pos > 0) {
+                const char neighbor = haystack[pos - 1];
+                position_bonus = (::islower(neighbor) && ::isupper(haystack[pos])) || neighbor == '_' || neighbor == ' ' ? 30 : 0;
+                if (k > 0 && pos - 1 >= first[k - 1] && pos - 1 <= last[k - 1] && (neighbor == lower[k - 1] || neighbor == upper[k - 1]))
+                    position_bonus += 15; // Sequential
+            }
+            best = ImMax(best, position_bonus);
+        }
+        bonus += best;
+    }
+    out_upper_bound = 100 + leading_penalty - (length - pattern_length) + bonus;
+    return true;
+}
+
+// FuzzySearchScoreCeiling() over haystacks of up to 'max_length' bytes
+static int CalcFuzzySearchScoreCeiling(const char* pattern, int max_length)
+{
+    // Best haystack for the pattern: its characters with a separator inserted wherever the bonus is worth the lost sequential bonus,
+    // the letters being cased to get camel case bonuses. Up to 256 bytes, no other character can raise the score
+    // The leading character scores 15 as the first letter, or 24 after a separator (-5 leading, -1 unmatched, +30)
+    if (*pattern == '\0')
+        return 0;
+    int ceiling_lower = ::isalpha(static_cast<unsigned char>(*pattern)) ? 100 + 24 : INT_MIN; // Best score with the last character matched in lower case
+    int ceiling_other = 100 + 24;                                  // Same in upper case, or for any other character
+    int pattern_length = 1;
+    for (const char* p = pattern + 1; *p != '\0'; ++p, ++pattern_length) {
+        const int prev_best = ImMax(ceiling_lower, ceiling_other);
+        const int separator_bonus = (p[-1] == '_' || p[-1] == ' ') ? 30 : 0;
+        const int upper_score = ImMax(ceiling_other + 15 + separator_bonus, ceiling_lower + 15 + 30); // Camel case after a lower case character
+        const int any_score = prev_best + ImMax(15 + separator_bonus, 30 - 1);                        // Adjacent, or after an inserted separator
+        if (::isalpha(static_cast<unsigned char>(*p))) {
+            ceiling_lower = any_score;
+            ceiling_other = ImMax(any_score, upper_score);
+        }
+        else {
+            ceiling_lower = INT_MIN;
+            ceiling_other = any_score;
+        }
+    }
+    const int ceiling = ImMax(ceiling_lower, ceiling_other);
+
+    // Past 256 bytes the match positions wrap around in FuzzySearchRecursive(), every character can then get both the sequential
+    // and the neighbor bonus, for at least 257 - pattern_length unmatched letters
+    if (max_length <= 256)
+        return ceiling;
+    const int wrapped_ceiling = 100 + 30 + 45 * (pattern_length - 1) - (257 - pattern_length);
+    return ImMax(ceiling, wrapped_ceiling);
+}
+
+int FuzzySearchScoreCeiling(const char* pattern)
+{
+    return CalcFuzzySearchScoreCeiling(pattern, INT_MAX);
+}
+
+int FuzzySearchScoreCeiling(const char* pattern, int min_length, int max_length, bool word_boundaries)
+{
+    if (*pattern == '\0')
+        return 0;
+    const int pattern_length = static_cast<int>(strlen(pattern));
+    const int unmatched = ImMax(min_length - pattern_length, 0);
+
+    // Without camel case or separator, the first character gets at most the first letter bonus and the others the sequential bonus,
+    // plus the first letter bonus when the match positions wrap around
+    if (!word_boundaries)
+        return 100 + 15 + (max_length > 256 ? 30 : 15) * (pattern_length - 1) - unmatched;
+
+    // Otherwise every character gets at most its best bonus (the first one loses 5 to the leading letter penalty when it gets 30),
+    // and the longer haystacks the search can wrap around in still get their unmatched letter penalty
+    const int length_ceiling = 100 + 25 + 45 * (pattern_length - 1) - unmatched;
+    return ImMin(CalcFuzzySearchScoreCeiling(pattern, max_length), length_ceiling);
+}
+
+bool FuzzySearchGreedy(const char* pattern, const char* haystack, int matched_count, int max_matches, int& inout_pos, int& inout_score)
+{
+    // Same scoring as FuzzySearchRecursive() below, including the match positions wrapping around past 255 bytes
+    // The score is updated for every matched character, the unmatched letter penalty being counted upfront for the whole haystack
+    int pos = 0;
+    int score = 0;
+    if (matched_count == 0) {
+        if (*pattern == '\0' || *haystack == '\0')
+            return false;
+        score = 100 - static_cast<int>(strlen(haystack));
+    }
+    else {
+        pos = inout_pos;
+        score = inout_score;
+    }
+    if (matched_count + static_cast<int>(strlen(pattern)) > max_matches)
+        return false;
+
+    int prev_pos = pos - 1;
+    for (const char* src = haystack + pos; *pattern != '\0' && *src != '\0'; ++src) {
+        if (tolower(*pattern) != tolower(*src))
+            continue;
+        const unsigned char curr_idx = static_cast<unsigned char>(src - haystack);
+        if (matched_count == 0)
+            score += ImMax(-5 * curr_idx, -15); // Leading letters
+        else if (curr_idx == static_cast<unsigned char>(prev_pos) + 1)
+            score += 15; // Sequential
+        if (curr_idx > 0) {
+            const char neighbor = haystack[curr_idx - 1];
+            const char curr = haystack[curr_idx];
+            if (::islower(neighbor) && ::isupper(curr))
+                score += 30; // Camel case
+            if (neighbor == '_' || neighbor == ' ')
+                score += 30; // Separator
+        }
+        else {
+            score += 15; // First letter
+        }
+        score += 1; // No longer an unmatched letter
+        prev_pos = static_cast<int>(src - haystack);
+        ++matched_count;
+        ++pattern;
+    }
+    if (*pattern != '\0')
+        return false;
+
+    inout_pos = prev_pos + 1;
+    inout_score = score;
+    return true;
+}
+
 static bool FuzzySearchRecursive(const char* pattern, const char* src, int& outScore, const char* strBegin, const unsigned char srcMatches[], unsigned char newMatches[], int maxMatches, int& nextMatch, int& recursionCount, int recursionLimit)
 {
     // Count recursions
@@ -32,6 +32,8 @@ namespace ImGui
 struct ComboAutoSelectData;
 struct ComboFilterData;
 struct ComboFilterSearchResultData;
+struct ComboPerfCounters;
+struct ComboSession;
 
 template<typename T1>
 struct ComboAutoSelectSearchCallbackData;
@@ -40,6 +42,14 @@ struct ComboFilterSearchCallbackData;
 
 using ComboFilterSearchResults = std::vector<ComboFilterSearchResultData>;
 
+// Extra flags for ComboAutoSelect/ComboFilter, passed along the ImGuiComboFlags in bits Dear ImGui does not use
+enum ImGuiComboFilterFlags_
+{
+	ImGuiComboFlags_AutoWidth      = 1 << 24, // Widen the popup to fit the widest item (up to the viewport width). Item widths are measured once per container and cached, long items are drawn with an ellipsis
+	ImGuiComboFlags_VariableHeight = 1 << 25, // Rows are as tall as the number of lines of their item ("name\npath"), instead of a single line. These popups (and ComboFilterTable ones) are not virtually scrolled, they list the first rows that fit in 2^24 pixels (about 1M one line rows), type a query to reach the others
+	ImGuiComboFlags_RetainDrawCache = 1 << 26, // Replay the list box rows drawn in a previous frame while nothing they depend on changed (query, scroll, hover, selection, items count and version, position, font, colors), for popups kept open and idle. Items other than a ComboItemSource are not read again, call ClearComboItemCaches() after changing them in place
+};
+
 // Callback for container of your choice
 // Index can be negative or out of range so you can customize the return value for invalid index
 template<typename T>
@@ -58,6 +68,126 @@ using ComboAutoSelectSearchCallback = int (*)(const ComboAutoSelectSearchCallbac
 template<typename T>
 using ComboFilterSearchCallback = void (*)(const ComboFilterSearchCallbackData<T>& callback_data);
 
+// Column of a ComboFilterTable popup
+// The getters are only called for the rows shown, and their texts are cached across frames (except for the item_getter column, which is shown as is)
+// Getters can then return a pointer to a temporary buffer, or look up details that are too expensive to be part of the searched item_getter string
+template<typename T>
+struct ComboFilterColumn
+{
+	const char*                Label;
+	ComboItemGetterCallback<T> Getter;              // NULL to show the search score
+	float                      InitWidth{ 0.0f };   // 0.0f to stretch the column
+};
+
+// Two-phase ranking of filter results, see DefaultComboFilterSearchCallback
+// [0, ExactCount) are scored by FuzzySearchEX and in their final order, [ExactCount, ScoredCount) are scored by FuzzySearchEX,
+// and the rest only have an upper bound of their score. Both counts are -1 when every result is in its final order
+struct ComboFilterRanking
+{
+	static constexpr int InitialExactCount = 256; // Ranked by the search, more than the rows a popup shows
+	static constexpr int RefineMargin      = 64;  // Ranked past the rows needed, so scrolling does not rank a few rows every frame
+
+	int ExactCount{ -1 };
+	int ScoredCount{ -1 };
+
+	bool IsFinal(int row_end) const { return ExactCount < 0 || row_end <= ExactCount; }
+};
+
+enum ComboItemSourceStorage
+{
+	ComboItemSourceStorage_Owned,    // The items are copied, the container can be discarded after registering/updating the source
+	ComboItemSourceStorage_Borrowed, // The container and item_getter are kept, the container must outlive the source
+	ComboItemSourceStorage_Dafsa,    // The items are compressed into a ComboDafsa, for very large vocabularies. Items are decoded on access
+};
+
+// Minimal acyclic automaton (DAFSA) of the item texts: common prefixes and suffixes are stored once, a fraction of the raw texts for large
+// vocabularies of identifiers or part numbers. Its words are numbered in byte order (ranks), each mapped to the first item with that text
+// Prefix lookups and decoding take O(length * alphabet) steps. A DAFSA source never builds the search indexes of a ComboItemSource
+// (they would hold the decoded texts): it is meant for PrefixComboAutoSelectSearchCallback, the other callbacks decode every item they search
+struct ComboDafsa
+{
+	// Every state is a byte offset in Nodes, its children are stored before it, the root last:
+	//   word count (varint), edge count << 1 | final (varint), then for every edge sorted by label (as unsigned char):
+	//   label count (varint), labels, distance back from this varint to the target state (varint)
+	// The states with a single edge, not final and reached by a single edge are stored as more labels on the edge leading to them
+	ImVector<unsigned char> Nodes;
+	ImU32                Root{ 0 };
+	int                  StateCount{ 0 };           // States stored in Nodes, the others being labels of an edge
+	ImVector<int>        ItemRanks;                 // Rank of the text of every item, empty when the items are sorted without duplicates (rank == index)
+	ImVector<int>        RankItems;                 // First item of every rank, empty in the same case
+	int                  ItemCount{ 0 };
+	int                  WordCount{ 0 };
+	size_t               RawTextSize{ 0 };          // Texts and offsets of every item, as ComboItemSourceStorage_Owned stores them
+
+	static constexpr int DecodeBufferCount = 4;
+	mutable ImVector<char> DecodeBuffers[DecodeBufferCount];
+	mutable int            DecodeBufferIndex{ 0 };
+
+	template<typename T1, typename T2>
+	void        Build(const T1& items, ComboItemGetterCallback<T2> item_getter);
+	void        Build(const char* texts, const int* offsets, int count); // Zero terminated texts at every offset
+	void        Clear();
+
+	int         size() const { return ItemCount; }
+	int         GetItemRank(int index) const { return ItemRanks.Size > 0 ? ItemRanks[index] : index; }
+	int         GetRankItem(int rank) const { return RankItems.Size > 0 ? RankItems[rank] : rank; }
+	const char* GetItem(int index) const;             // Decoded into one of DecodeBufferCount buffers used in turn, "" for an invalid index
+	void        GetWord(int rank, ImVector<char>& out_text) const;
+	int         FindWord(const char* text) const;     // Rank of the text, -1 if it is not an item
+	bool        FindPrefix(const char* prefix, int& out_rank_begin, int& out_rank_end) const; // Ranks [begin, end) of the words starting with the prefix
+	int         FindFirstWordWithPrefixIgnoreCase(const char* prefix) const;                  // Lowest rank of the words starting with the prefix, ignoring case like FuzzySearchEX, -1 if none does
+	size_t      CalcMemoryUsage() const;
+};
+
+// Item list registered once and shared by any number of ComboAutoSelect/ComboFilter (e.g. one combo per table row picking from the same list)
+// Everything derived from the items is built once per source instead of once per combo: the search indexes on the first search,
+// and the widths measured for ImGuiComboFlags_AutoWidth. Both are rebuilt when the Version changes
+// Get one with RegisterComboItemSource(), its address stays valid until UnregisterComboItemSource()
+struct ComboItemSource
+{
+	ImGuiID                ID{ 0 };
+	ComboItemSourceStorage Storage{ ComboItemSourceStorage_Owned };
+	int                    Version{ 0 };              // Incremented every time the items change
+	int                    Count{ 0 };
+
+	// Owned storage
+	ImVector<char>         OwnedTexts;                // Zero terminated texts of every item
+	ImVector<int>          OwnedOffsets;
+	// Borrowed storage, type erased
+	const void*            BorrowedItems{ nullptr };
+	void                 (*BorrowedGetter)(){ nullptr };
+	const char*          (*BorrowedThunk)(const ComboItemSource& source, int index){ nullptr };
+	// DAFSA storage
+	ComboDafsa             Dafsa;
+
+	// Search indexes, built by BuildIndexes() for the current Version
+	mutable ImVector<char>  FoldedTexts;              // Zero terminated, lower case texts of every item (folded like FuzzySearchEX compares them)
+	mutable ImVector<int>   FoldedOffsets;
+	mutable ImVector<ImU64> Signatures;               // Characters present in every item, see CalcComboItemSignature()
+	mutable int             MinItemLength{ 0 };       // Bounds of the FuzzySearchEX scores of the items, see FuzzySearchScoreCeiling()
+	mutable int             MaxItemLength{ 0 };
+	mutable bool            HasWordBoundaries{ false }; // An item has a camel case or separator boundary
+	mutable int             IndexesVersion{ -1 };
+	// Prefix index, built by BuildPrefixIndex() for the current Version
+	mutable ImVector<int>   SortedOrder;              // Item indexes sorted by folded text, then by index
+	mutable int             PrefixIndexVersion{ -1 };
+	// Substring index, built by BuildSuffixIndex() for the current Version
+	mutable ImVector<int>   SuffixArray;              // Offsets in FoldedTexts of every suffix of every item, sorted by suffix (up to the end of its item)
+	mutable ImVector<int>   SuffixItems;              // Item of every suffix of SuffixArray
+	mutable int             SuffixIndexVersion{ -1 };
+	mutable double          SuffixIndexBuildTime{ 0.0 }; // In seconds
+
+	int         size() const { return Count; }
+	const char* GetItem(int index) const;             // "" for an invalid index
+	const char* GetFoldedItem(int index) const { return FoldedTexts.Data + FoldedOffsets[index]; }
+	void        BuildIndexes() const;                 // Does nothing if they are up to date
+	void        BuildPrefixIndex() const;             // Builds the search indexes too, does nothing if it is up to date
+	void        FindPrefixRange(const char* folded_prefix, int& out_begin, int& out_end) const; // [out_begin, out_end) of SortedOrder, binary searched
+	void        BuildSuffixIndex() const;             // Builds the search indexes too, does nothing if it is up to date
+	void        FindSubstringRange(const char* folded_query, int& out_begin, int& out_end) const; // [out_begin, out_end) of SuffixArray, binary searched
+	size_t      CalcMemoryUsage() const;
+};
+
 // ComboData related queries
 // Lookup requires the combo_id gotten from hashing the combo_name/label
 // Alternatively, if you know the window the combo is in, you can input the window_name and combo_name
@@ -65,10 +195,113 @@ using ComboFilterSearchCallback = void (*)(const ComboFilterSearchCallbackData<T
 void ClearComboData(const char* window_label, const char* combo_label);
 void ClearComboData(const char* combo_label);
 void ClearComboData(ImGuiID combo_id);
-
+// Clears every combo data not used by a widget in the last 'max_idle_frames' frames and returns how many were cleared
+// A cleared combo gets a new combo data the next time its popup opens, and shows the preview of 'selected_item' until then
+int ClearIdleComboData(int max_idle_frames);
+
+// Debug window listing every combo data in the internal storage, with its memory usage and a button to clear the idle ones
+// Useful to find combos whose data is never cleared (e.g. combos with generated labels/ids)
+void ShowComboDebugWindow(bool* p_open = NULL);
+
+// Item widths measured for ImGuiComboFlags_AutoWidth are cached per container address ('&items'), and only new items are measured when the container grows
+// The cache is checked against a sample of the items (see Internal::CalcComboItemsSignature) when a popup opens, so a temporary or a reused address is measured again
+// Clear the cache of a container whose items were modified in place (or of every container if NULL), it is measured again the next time a popup shows it
+void ClearComboItemWidthCache(const void* items_source = NULL);
+// Drops what a combo cached from its items (the rows kept by ImGuiComboFlags_RetainDrawCache, the column texts of ComboFilterTable, the query history), for items modified in place that are not a ComboItemSource
+// Unlike ClearComboData(), the query and the selection of an open popup are kept
+void ClearComboItemCaches(ImGuiID combo_id);
+
+// Item sources
+// The name is hashed into the source ID, registering a name twice is an error
+// Borrowed sources have to be updated after their container is modified, with the new container or in place (no arguments) when it is still at the same address
+template<typename T1, typename T2, typename = std::enable_if<std::is_convertible<T1, T2>::value>::type>
+ComboItemSource* RegisterComboItemSource(const char* name, const T1& items, ComboItemGetterCallback<T2> item_getter, ComboItemSourceStorage storage = ComboItemSourceStorage_Owned);
+template<typename T1, typename T2, typename = std::enable_if<std::is_convertible<T1, T2>::value>::type>
+void UpdateComboItemSource(ComboItemSource* source, const T1& items, ComboItemGetterCallback<T2> item_getter);
+void UpdateComboItemSource(ComboItemSource* source);
+void UnregisterComboItemSource(ComboItemSource* source);
+ComboItemSource* FindComboItemSource(const char* name);
+ComboItemSource* FindComboItemSource(ImGuiID source_id);
+const char* GetComboItemSourceItem(const ComboItemSource& source, int index); // Item getter of the ComboItemSource overloads
+// Search indexes are built by the first search needing them, on the thread drawing the widget, and dropped when the items change
+// Build them beforehand (e.g. after registering/updating the source, during a loading screen) to keep the first keystroke responsive
+// A source must not be searched while its indexes are being built on another thread
+void BuildComboItemSourcePrefixIndex(const ComboItemSource* source); // For PrefixComboAutoSelectSearchCallback, DAFSA sources do not need one
+void BuildComboItemSourceSuffixIndex(const ComboItemSource* source); // For SubstringComboFilterSearchCallback, seconds for a million items (see SuffixIndexBuildTime). DAFSA sources are scanned instead
+
+// Query result cache
+// The results of ComboFilter searches in a ComboItemSource are cached by source, version, query and search callback, and shared by every combo listing the source
+// A query typed again in any of them is then copied from the cache instead of searched. Plain containers are never cached, as their changes cannot be detected
+// The least recently used results are evicted past the memory budget (16 MB by default), 0 disables the cache
+void SetComboResultCacheBudget(size_t max_bytes);
+size_t GetComboResultCacheBudget();
+void ClearComboResultCache(const void* items_source = NULL); // Only the results of 'items_source' if not NULL
+
+// Stable sorts of search results by score, results with the same score keep their order (the item order for a search over every item)
 void SortFilterResultsDescending(ComboFilterSearchResults& filtered_items);
 void SortFilterResultsAscending(ComboFilterSearchResults& filtered_items);
 
+// Performance counters
+// Records per combo how much work the search callback did, how long the search and the sort took, and the keystroke-to-results latency
+// They are off by default and cost a single branch per search when off. Define IMGUI_COMBO_FILTER_DISABLE_PERF_COUNTERS to compile them out completely
+// Lookup works the same as the ComboData queries, and returns NULL if nothing was recorded for that combo
+void SetComboPerfCountersEnabled(bool enabled);
+bool GetComboPerfCountersEnabled();
+const ComboPerfCounters* GetComboPerfCounters(const char* window_label, const char* combo_label);
+const ComboPerfCounters* GetComboPerfCounters(const char* combo_label);
+const ComboPerfCounters* GetComboPerfCounters(ImGuiID combo_id);
+void ResetComboPerfCounters();
+void ExportComboPerfCountersJSON(ImGuiTextBuffer& out_buf);
+void ExportComboPerfCountersCSV(ImGuiTextBuffer& out_buf);
+
+// Tracing hooks
+// Begin/end events emitted around the phases of the widgets, so they can be forwarded to an external profiler/tracer
+// The events are only emitted if IMGUI_COMBO_FILTER_ENABLE_TRACING is defined, otherwise they are compiled out and the hooks are never called
+// combo_id is the id of the widget. For ComboTracePhase_Sort it is the id of the combo being searched, or 0 when sorting outside of a search
+enum ComboTracePhase
+{
+	ComboTracePhase_PopupSetup, // Popup size constraints, positioning and Begin()
+	ComboTracePhase_Search,     // The search callback invocation, sort included
+	ComboTracePhase_Sort,       // SortFilterResultsDescending/Ascending
+	ComboTracePhase_Clipper,    // The ImGuiListClipper loop listing the items
+	ComboTracePhase_COUNT
+};
+using ComboTraceHookCallback = void (*)(ComboTracePhase phase, ImGuiID combo_id, void* user_data);
+
+void SetComboTraceHooks(ComboTraceHookCallback begin_hook, ComboTraceHookCallback end_hook, void* user_data = NULL);
+const char* GetComboTracePhaseName(ComboTracePhase phase);
+
+// Session recording
+// Records the interactions with a single combo (popup open/close, query edits, keyboard navigation, selection) with their timestamps,
+// so they can be replayed headlessly to reproduce and time what the user did (see session-replay.cpp)
+// The events are buffered in memory and written to 'filename' by StopComboSessionRecording(). Only one combo can be recorded at a time
+// File format: "ICSR" magic and a version byte, then for every event its time since the previous event in microseconds (varint),
+// its ComboSessionEventType (byte) and its payload:
+//   Open:   widget kind (varint, 0 ComboFilter/1 ComboAutoSelect), flags (varint), item count (varint)
+//   Query:  query length (varint) and bytes, the whole query after the edit
+//   Select: index of the clicked row as listed (varint)
+//   Other events have no payload
+enum ComboSessionEventType
+{
+	ComboSessionEvent_Open,
+	ComboSessionEvent_Close,  // Closed by clicking outside the popup
+	ComboSessionEvent_Query,
+	ComboSessionEvent_Up,
+	ComboSessionEvent_Down,
+	ComboSessionEvent_Enter,
+	ComboSessionEvent_Escape,
+	ComboSessionEvent_Select,
+	ComboSessionEvent_COUNT
+};
+
+bool StartComboSessionRecording(const char* window_label, const char* combo_label, const char* filename);
+bool StartComboSessionRecording(const char* combo_label, const char* filename);
+bool StartComboSessionRecording(ImGuiID combo_id, const char* filename);
+bool StopComboSessionRecording();  // Returns false if nothing was recorded or the file could not be written
+bool IsComboSessionRecording();
+bool LoadComboSession(const char* filename, ComboSession& out_session);
+const char* GetComboSessionEventName(ComboSessionEventType type);
+
 // Combo box with text filter
 // T1 should be a container.
 // T2 can be, but not necessarily, the same as T1 but it should be convertible from T1 (e.g. std::vector<...> -> std::span<...>)
@@ -83,6 +316,17 @@ template<typename T1, typename T2, typename = std::enable_if<std::is_convertible
 bool ComboFilter(const char* combo_label, int& selected_item, const T1& items, ComboItemGetterCallback<T2> item_getter, ComboFilterSearchCallback<T2> filter_callback, ImGuiComboFlags flags = ImGuiComboFlags_None);
 template<typename T1, typename T2, typename = std::enable_if<std::is_convertible<T1, T2>::value>::type>
 bool ComboFilter(const char* combo_label, int& selected_item, const T1& items, ComboItemGetterCallback<T2> item_getter, ImGuiComboFlags flags = ImGuiComboFlags_None);
+// ComboFilter with a table popup, items are still searched and previewed with item_getter
+// The first column holds the row selection, pass item_getter as its getter to show the searched string there
+template<typename T1, typename T2, typename = std::enable_if<std::is_convertible<T1, T2>::value>::type>
+bool ComboFilterTable(const char* combo_label, int& selected_item, const T1& items, ComboItemGetterCallback<T2> item_getter, const ComboFilterColumn<T2>* columns, int columns_count, ComboFilterSearchCallback<T2> filter_callback, ImGuiComboFlags flags = ImGuiComboFlags_None);
+template<typename T1, typename T2, typename = std::enable_if<std::is_convertible<T1, T2>::value>::type>
+bool ComboFilterTable(const char* combo_label, int& selected_item, const T1& items, ComboItemGetterCallback<T2> item_getter, const ComboFilterColumn<T2>* columns, int columns_count, ImGuiComboFlags flags = ImGuiComboFlags_None);
+// Widgets listing a registered ComboItemSource, the default search callbacks use its shared search indexes
+bool ComboAutoSelect(const char* combo_label, int& selected_item, const ComboItemSource* source, ComboAutoSelectSearchCallback<const ComboItemSource&> autoselect_callback, ImGuiComboFlags flags = ImGuiComboFlags_None);
+bool ComboAutoSelect(const char* combo_label, int& selected_item, const ComboItemSource* source, ImGuiComboFlags flags = ImGuiComboFlags_None);
+bool ComboFilter(const char* combo_label, int& selected_item, const ComboItemSource* source, ComboFilterSearchCallback<const ComboItemSource&> filter_callback, ImGuiComboFlags flags = ImGuiComboFlags_None);
+bool ComboFilter(const char* combo_label, int& selected_item, const ComboItemSource* source, ImGuiComboFlags flags = ImGuiComboFlags_None);
 
 namespace Internal
 {
@@ -96,19 +340,353 @@ T* AddComboData(const char* combo_label);
 template<class T>
 T* AddComboData(ImGuiID combo_id);
 template<class T>
+T* AddComboData(ImGuiWindow* window, ImGuiID combo_id);
+template<class T>
 T* GetComboData(const char* window_label, const char* combo_label);
 template<class T>
 T* GetComboData(const char* combo_label);
 template<class T>
 T* GetComboData(ImGuiID combo_id);
+// Lookup for the widgets, through the slot in the window state storage
+template<class T>
+T* FindComboData(ImGuiWindow* window, ImGuiID combo_id);
 
 // ImGui helpers for most widget needs
+struct ComboRowHeights;
 float CalcComboItemHeight(int item_count, float offset_multiplier = 1.0f);
-void SetScrollToComboItemJump(ImGuiWindow* listbox_window, int index);
-void SetScrollToComboItemUp(ImGuiWindow* listbox_window, int index);
-void SetScrollToComboItemDown(ImGuiWindow* listbox_window, int index);
+// Popups that are not virtually scrolled only list the rows that fit in ComboMaxListedHeight pixels, float positions past it are off by more than a pixel
+constexpr float ComboMaxListedHeight = static_cast<float>(1 << 24);
+int ClampComboListedRows(int row_count);
+// Rows are assumed one line tall when 'heights' is NULL. When the list box is virtually scrolled, its logical position is moved instead of its scroll
+void SetScrollToComboItemJump(ImGuiWindow* listbox_window, int index, const ComboRowHeights* heights = NULL);
+void SetScrollToComboItemUp(ImGuiWindow* listbox_window, int index, const ComboRowHeights* heights = NULL);
+void SetScrollToComboItemDown(ImGuiWindow* listbox_window, int index, const ComboRowHeights* heights = NULL);
 void UpdateInputTextAndCursor(char* buf, int buf_capacity, const char* new_str);
 
+// Row heights for ImGuiComboFlags_VariableHeight. Rows are estimated one line tall until they are measured, and a Fenwick tree over
+// the height each measured row adds to its estimate gives the position of a row, or the row at a position, in O(log N)
+// Rows are measured lazily, only where they are shown or scrolled to, so a far jump does not measure the rows in between
+// Invalidate() whenever the listed rows change, a change of font or a smaller row count resets the measurements on the next Update()
+struct ComboRowHeights
+{
+	ImVector<float> Extra;                // Fenwick tree (Extra[i - 1] is node i) of the measured heights minus the estimated ones, over RowCount rows
+	ImVector<ImU32> Measured;             // One bit per measured row
+	int             RowCount{ 0 };
+	int             MeasuredCount{ 0 };
+	float           LineHeight{ 0.0f };
+	float           Spacing{ 0.0f };
+
+	int   GetMeasuredCount() const { return MeasuredCount; }
+	bool  IsMeasured(int row) const { return (Measured[row >> 5] >> (row & 31)) & 1; }
+	float GetEstimatedHeight() const { return LineHeight + Spacing; }
+	float GetRowHeight(const char* label) const;
+	float GetTop(int row) const;          // Measured, or estimated for the rows above it that were not measured yet
+	float GetHeight(int row) const { return GetTop(row + 1) - GetTop(row); }
+	float GetTotalHeight() const { return GetTop(RowCount); }
+	int   FindRow(float y) const;         // Row under 'y' (relative to the first row), clamped to the rows
+	void  Invalidate() { Extra.clear(); Measured.clear(); RowCount = MeasuredCount = 0; }
+	void  Resize(int row_count);          // New rows are estimated, the measured ones are kept
+	void  SetMeasuredHeight(int row, float height);
+
+	// Measures the rows of [row_begin, row_end) not measured yet
+	template<typename F>
+	void Measure(int row_begin, int row_end, F&& row_label)
+	{
+		row_end = ImMin(row_end, RowCount);
+		for (int row = ImMax(row_begin, 0); row < row_end; ++row)
+			if (!IsMeasured(row))
+				SetMeasuredHeight(row, GetRowHeight(row_label(row)));
+	}
+
+	// Measures the rows between 'y_begin' and 'y_end', as the measured ones push the next ones down
+	template<typename F>
+	void MeasureRange(float y_begin, float y_end, F&& row_label)
+	{
+		for (int row = RowCount > 0 ? FindRow(y_begin) : 0; row < RowCount && GetTop(row) < y_end; ++row)
+			if (!IsMeasured(row))
+				SetMeasuredHeight(row, GetRowHeight(row_label(row)));
+	}
+
+	// Measures 'row' and the rows above it over 'height' pixels, so the row can be scrolled to without the rows shown above it moving it afterwards
+	template<typename F>
+	void MeasureAbove(int row, float height, F&& row_label)
+	{
+		if (row < 0 || row >= RowCount)
+			return;
+		Measure(row, row + 1, row_label);
+		Measure(FindRow(GetTop(row) - height), row, row_label);
+	}
+
+	// Once per frame, before the rows are measured
+	void Update(int row_count)
+	{
+		const ImGuiContext& g = *GImGui;
+		if (LineHeight != g.FontSize || Spacing != g.Style.ItemSpacing.y || row_count < RowCount) {
+			Invalidate();
+			LineHeight = g.FontSize;
+			Spacing = g.Style.ItemSpacing.y;
+		}
+		Resize(row_count);
+	}
+};
+
+// Virtual scrolling for lists of one line rows too tall for float positions to address each row precisely (a few million rows)
+// The logical position is a fractional row index, and is mapped onto a bounded physical scroll range for the scrollbar
+// Mouse wheel and keyboard scrolling move the logical position by rows, dragging the scrollbar moves it proportionally
+struct ComboVirtualScroll
+{
+	static constexpr float MaxPhysicalHeight = static_cast<float>(1 << 21); // Content taller than this is virtually scrolled, float positions are still precise to 1/4 pixel
+
+	double TopRow{ 0.0 };         // Logical position, the row at the top of the list box
+	double MaxTopRow{ 0.0 };
+	double VisibleRows{ 0.0 };
+	float  ViewTop{ 0.0f };       // Screen position of the top of the list box content this frame
+	float  LastScrollY{ -1.0f };  // Physical scroll set last frame, a different one means the scrollbar was dragged (or the scroll set by code)
+	bool   Active{ false };
+
+	void SetTopRow(double top_row) { TopRow = ImClamp(top_row, 0.0, MaxTopRow); }
+};
+
+// Once per frame in the list box, before BeginComboListRows() and any scroll to item. Returns NULL when the content fits in a float
+ComboVirtualScroll* UpdateComboVirtualScroll(ComboVirtualScroll& virtual_scroll, ImGuiWindow* listbox_window, int row_count);
+// Instead of UpdateComboVirtualScroll() in list boxes that are not virtually scrolled this frame (variable height rows, tables), so the scroll to item helpers do not find a stale virtual scroll
+void ClearComboVirtualScroll(ComboVirtualScroll& virtual_scroll, ImGuiWindow* listbox_window);
+
+// Lightweight list box rows, drawn like Selectable() but without formatting/hashing an id and laying out an item per row
+// Rows share a single item for the mouse interactions, the hovered and pressed rows are computed from the mouse position
+// Call BeginComboListRows() before the ComboListClipper loop and RenderComboListRow() for every listed row
+struct ComboListRows
+{
+	ImVec2                    StartPos;                 // Position of BaseRow
+	float                     RowHeight;
+	float                     MaxX;
+	int                       BaseRow{ 0 };             // First row of a virtually scrolled list box, 0 otherwise
+	const ComboRowHeights*    Heights{ nullptr };       // NULL when every row is RowHeight tall
+	const ComboVirtualScroll* VirtualScroll{ nullptr }; // NULL when the list box is not virtually scrolled
+	int                    HoveredRow{ -1 };
+	int                    PressedRow{ -1 };   // Row clicked this frame, -1 if none
+	bool                   Held{ false };
+};
+
+// Steps over the visible rows like ImGuiListClipper, which it uses for rows of a fixed height
+// Variable height and virtually scrolled rows are stepped in a single pass, then the cursor is moved past the last row to size the content
+struct ComboListClipper
+{
+	ImGuiListClipper       Clipper;
+	const ComboListRows*   Rows{ nullptr };
+	int                    RowCount{ 0 };
+	int                    DisplayStart{ 0 };
+	int                    DisplayEnd{ 0 };
+	int                    StepNo{ 0 };
+
+	void Begin(const ComboListRows& rows, int row_count);
+	bool Step();
+};
+
+ComboListRows BeginComboListRows(int row_count, const ComboRowHeights* heights = NULL, const ComboVirtualScroll* virtual_scroll = NULL);
+void RenderComboListRow(const ComboListRows& rows, int row, const char* label, bool selected, float label_width = -1.0f); // Pass the known label width to get an ellipsis instead of clipped text
+
+// Item widths for ImGuiComboFlags_AutoWidth, at the font and size they were measured with
+// The cache is reset when the font changes, when the container shrinks, when the sampled items differ or with ClearComboItemWidthCache()
+struct ComboItemWidthCache
+{
+	static constexpr int MeasureBudget = 1 << 16; // Items measured per frame, so very large containers are measured over a few frames instead of stalling one
+
+	ImVector<float> Widths;
+	float           MaxWidth{ 0.0f };
+	ImFont*         Font{ nullptr };
+	float           FontSize{ 0.0f };
+	int             LastUsedFrame{ -1 };
+	ImGuiID         ItemsSignature{ 0 }; // CalcComboItemsSignature() of the measured items
+
+	float GetWidth(int index) const { return index >= 0 && index < Widths.Size ? Widths[index] : -1.0f; }
+	void  Reset() { Widths.clear(); MaxWidth = 0.0f; ItemsSignature = 0; }
+};
+
+// Vertices and indices of the list box rows drawn in a previous frame, for ImGuiComboFlags_RetainDrawCache
+// The rows are recorded between BeginRecord() and EndRecord(), and replayed instead of being drawn again while the signature is unchanged
+// Items modified in place are only detected through the version of a ComboItemSource, call ClearComboItemCaches() after changing other containers
+struct ComboDrawCache
+{
+	ImVector<ImDrawVert> Vertices;
+	ImVector<ImDrawIdx>  Indices;           // Relative to the first recorded vertex
+	ImGuiID              Signature{ 0 };
+	float                CursorEndY{ 0.0f }; // Layout after the rows, relative to the rows position
+	float                CursorMaxY{ 0.0f };
+	bool                 Valid{ false };
+
+	// Recording state
+	int                  RecordVtxStart{ 0 };
+	int                  RecordIdxStart{ 0 };
+	int                  RecordCmdCount{ 0 };
+	unsigned int         RecordVtxCurrentIdx{ 0 };
+
+	bool Replay(ImGuiID signature, const ComboListRows& rows); // Returns false if the rows have to be drawn (and recorded)
+	void BeginRecord();
+	void EndRecord(ImGuiID signature, const ComboListRows& rows);
+};
+
+// Column texts of ComboFilterTable, cached per item index and column for the rows shown
+// The oldest half is dropped when MaxEntries is reached, everything when the items version or count changes (or on ClearComboItemCaches())
+struct ComboColumnTextCache
+{
+	static constexpr int MaxEntries = 4096;
+
+	struct Entry
+	{
+		int ItemIndex;
+		int Column;
+		int TextOffset;
+	};
+
+	ImGuiStorage    Lookup;                 // Hash of the item index and column to the entry index + 1
+	ImVector<Entry> Entries;
+	ImVector<char>  Texts;                  // Zero terminated texts of every entry
+	int             ItemsVersion{ 0 };      // GetContainerVersion() of the items the texts were read from
+	int             ItemsCount{ 0 };
+
+	void        Validate(int items_version, int items_count);
+	const char* Find(int item_index, int column) const;
+	const char* Add(int item_index, int column, const char* text); // Returns the cached copy, valid until the next Add()
+	void        DropOldest(int count);
+	void        Clear();
+	size_t      CalcMemoryUsage() const;
+};
+
+// Greedy match of an item, see IncrementalComboFilterSearchCallback
+struct ComboResumeMatch
+{
+	int Index;
+	int Pos;   // Byte after the last matched character
+	int Score; // Greedy score of the match so far
+};
+
+// Queries searched since an open ComboFilter popup was last cleared, with their results
+// The entries form a chain of queries each starting with the previous one, so going back to a shorter query (backspace) restores its results instead of searching again,
+// and a longer query only has to search the results of the last entry (see ComboFilterSearchCallbackData::PreviousResults)
+// Everything is dropped when the search engine or the items signature (version and count, sampled texts of plain containers) changes, or on ClearComboItemCaches()
+struct ComboQueryHistory
+{
+	static constexpr int    MaxEntries = 16;       // The shortest queries are dropped first
+	static constexpr size_t MaxBytes   = 16 << 20; // Same, the results of a query larger than this alone are not kept
+
+	struct Entry
+	{
+		ImVector<char>           Query;
+		ComboFilterSearchResults Results;
+		ComboFilterRanking       Ranking;
+	};
+
+	std::vector<Entry> Entries;
+	size_t             EntriesBytes{ 0 };
+	ImGuiID            EngineID{ 0 };
+	ImGuiID            ItemsSignature{ 0 }; // CalcComboItemsSignature() of the searched items, so the results never index past the items
+
+	void         Validate(ImGuiID engine_id, ImGuiID items_signature);
+	void         Truncate(const char* query); // Drops the entries 'query' does not start with
+	const Entry* GetLast() const { return Entries.empty() ? NULL : &Entries.back(); }
+	void         Push(const char* query, const ComboFilterSearchResults& results, const ComboFilterRanking& ranking);
+	void         Clear() { Entries.clear(); EntriesBytes = 0; }
+	size_t       CalcMemoryUsage() const;
+	static size_t CalcEntryMemoryUsage(const Entry& entry);
+};
+
+// Radix sort of SortFilterResultsDescending/Ascending, and an insertion sort for small results
+// The radix sort allocates a scratch copy of the results, freed before returning, so concurrent sorts do not share state
+constexpr int SortInsertionThreshold = 64;
+void SortFilterResultsStable(ComboFilterSearchResults& results, bool descending);
+// Sorts [mid, end) by descending score then ascending index, and merges it with [begin, mid), already sorted that way
+void MergeComboFilterResults(ComboFilterSearchResults& results, int begin, int mid, int end);
+// Scores results by FuzzySearchEX in order of upper bound, until at least 'min_exact_count' of them are in their final order
+// The final order is by descending score then ascending index
+template<typename F>
+void RefineComboFilterResults(ComboFilterSearchResults& results, ComboFilterRanking& ranking, int min_exact_count, const char* query, F&& item_text);
+template<typename T1, typename T2>
+void RefineComboFilterRows(ComboFilterData& combo_data, const T1& items, ComboItemGetterCallback<T2> item_getter, int row_end);
+
+// Indexes of previous results in ascending order, the order a full scan would search them in
+void GetComboNarrowedCandidates(const ComboFilterSearchResults& previous_results, ImVector<int>& out_indexes);
+
+// Greedy match states of IncrementalComboFilterSearchCallback, kept aside from the results so the next keystroke resumes them
+// A state is keyed by the items signature and its query, the least recently used ones are dropped past MaxResumeStates or MaxResumeStateBytes
+constexpr int    MaxComboResumeStates      = 8;
+constexpr size_t MaxComboResumeStateBytes  = 16 << 20;
+ImGuiID CalcComboResumeStateKey(ImGuiID items_signature, const char* query);
+const ImVector<ComboResumeMatch>* FindComboResumeState(ImGuiID key); // NULL if the state was dropped
+void AddComboResumeState(ImGuiID key, ImVector<ComboResumeMatch>& matches); // Takes the matches, 'matches' is left with unspecified contents
+void ClearComboResumeStates();
+
+// Hash of everything the drawn rows depend on, 'measured_widths' is for state the widget knows changed the rows
+// The items are only identified by their count and version (see GetContainerVersion), the texts are never read
+ImGuiID CalcComboDrawSignature(const ComboListRows& rows, int row_count, int selection, const char* query, int items_count, int items_version, int measured_widths);
+
+// Item source helpers
+ComboItemSource* AddComboItemSource(const char* name);
+void OnComboItemSourceChanged(ComboItemSource& source); // Bumps the version, dropping the search indexes and the measured widths
+template<typename T1, typename T2>
+void SetComboItemSourceItems(ComboItemSource& source, const T1& items, ComboItemGetterCallback<T2> item_getter);
+// Results cache helpers, FindComboCachedResults() copies the results into 'out_results' and returns false if the query was not cached
+// 'engine_id' identifies the filter callback and the item getter, the same items shown by two getters are cached apart
+bool FindComboCachedResults(const void* items_source, int items_version, ImGuiID engine_id, const char* query, ComboFilterSearchResults& out_results, ComboFilterRanking& out_ranking);
+void AddComboCachedResults(const void* items_source, int items_version, ImGuiID engine_id, const char* query, const ComboFilterSearchResults& results, const ComboFilterRanking& ranking);
+// One bit per lower case letter, per digit, and per group of other bytes. An item can only match a query whose signature bits it all has
+ImU64 CalcComboItemSignature(const char* folded_text);
+
+ComboItemWidthCache* GetComboItemWidthCache(const void* items_source);  // Creates the cache, and resets it if the current font differs
+ComboItemWidthCache* FindComboItemWidthCache(const void* items_source); // NULL if the container was never measured
+// The measured items are checked against the container only when 'validate' is set (when the popup opens), later frames only measure the new items
+template<typename T1, typename T2>
+ComboItemWidthCache* UpdateComboItemWidthCache(const T1& items, ComboItemGetterCallback<T2> item_getter, bool validate);
+// Identifies the first 'count' items for the caches keyed by the container address, so a temporary or a reused address does not hit stale data
+// A ComboItemSource is identified by its ID and version, other containers by their size and the texts of a few evenly spaced items
+constexpr int ComboItemsSignatureSamples = 8;
+template<typename T1, typename T2>
+ImGuiID CalcComboItemsSignature(const T1& items, ComboItemGetterCallback<T2> item_getter, int count);
+template<typename T2>
+ImGuiID CalcComboItemsSignature(const ComboItemSource& source, ComboItemGetterCallback<T2> item_getter, int count);
+float CalcComboAutoPopupWidth(float min_width, float max_item_width);
+void RenderComboPreview(const ImRect& bb, const char* preview, float preview_width);
+
+// Perf counters helpers for the widgets
+// BeginComboPerfSearch() returns NULL when the counters are disabled, and the sort functions account their time to the returned counters until EndComboPerfSearch()
+#ifndef IMGUI_COMBO_FILTER_DISABLE_PERF_COUNTERS
+ComboPerfCounters* BeginComboPerfSearch(ImGuiID combo_id, const char* combo_label);
+void EndComboPerfSearch(ComboPerfCounters* counters, int items_scanned, int matches_produced);
+void RecordComboPerfResultsShown(ImGuiID combo_id);
+#else
+inline ComboPerfCounters* BeginComboPerfSearch(ImGuiID, const char*) { return NULL; }
+inline void EndComboPerfSearch(ComboPerfCounters*, int, int) {}
+inline void RecordComboPerfResultsShown(ImGuiID) {}
+#endif
+
+// Session recording helpers for the widgets, they do nothing unless the combo is the one being recorded
+void RecordComboSessionEvent(ImGuiID combo_id, ComboSessionEventType type, int value = 0);
+void RecordComboSessionOpen(ImGuiID combo_id, int widget_kind, ImGuiComboFlags flags, int item_count);
+void RecordComboSessionQuery(ImGuiID combo_id, const char* query);
+
+// Tracing helpers for the widgets
+#ifdef IMGUI_COMBO_FILTER_ENABLE_TRACING
+void ComboTraceBegin(ComboTracePhase phase, ImGuiID combo_id);
+void ComboTraceEnd(ComboTracePhase phase, ImGuiID combo_id);
+
+struct ComboTraceScope
+{
+	ComboTracePhase Phase;
+	ImGuiID         ComboID;
+
+	ComboTraceScope(ComboTracePhase phase, ImGuiID combo_id) : Phase(phase), ComboID(combo_id) { ComboTraceBegin(Phase, ComboID); }
+	~ComboTraceScope() { ComboTraceEnd(Phase, ComboID); }
+};
+
+#define IMGUI_COMBO_TRACE_BEGIN(_PHASE, _ID) ImGui::Internal::ComboTraceBegin(_PHASE, _ID)
+#define IMGUI_COMBO_TRACE_END(_PHASE, _ID)   ImGui::Internal::ComboTraceEnd(_PHASE, _ID)
+#define IMGUI_COMBO_TRACE_SCOPE(_PHASE, _ID) ImGui::Internal::ComboTraceScope IM_CONCAT(combo_trace_scope_, __LINE__)(_PHASE, _ID)
+#else
+#define IMGUI_COMBO_TRACE_BEGIN(_PHASE, _ID) ((void)0)
+#define IMGUI_COMBO_TRACE_END(_PHASE, _ID)   ((void)0)
+#define IMGUI_COMBO_TRACE_SCOPE(_PHASE, _ID) ((void)0)
+#endif
+
 // Created my own std::size and std::empty implementation to avoid additional header dependency
 template<typename T>
 constexpr auto GetContainerSize(const T& item);
@@ -118,19 +696,53 @@ template<typename T>
 constexpr bool IsContainerEmpty(const T& item);
 template<typename T, unsigned long long N>
 constexpr bool IsContainerEmpty(const T(&array)[N]) noexcept;
+// Incremented when the items change, only tracked by ComboItemSource
+template<typename T>
+constexpr int GetContainerVersion(const T&) noexcept { return 0; }
+inline int GetContainerVersion(const ComboItemSource& source) noexcept { return source.Version; }
 
 bool FuzzySearchEX(char const* pattern, char const* src, int& out_score);
 bool FuzzySearchEX(char const* pattern, char const* haystack, int& out_score, unsigned char matches[], int maxMatches, int& outMatches);
+// Greedy subsequence match and an upper bound of the FuzzySearchEX score, from the earliest and latest position of every query character
+// Matches the same items as FuzzySearchEX, the bound gives every query character the best bonus of the positions it can be matched at
+bool FuzzySearchScoreUpperBound(const char* pattern, const char* haystack, int max_matches, int& out_upper_bound);
+// Greedy match, the first path FuzzySearchEX tries, with its score: it matches the same items, with a score lower than or equal to FuzzySearchEX's
+// Resumable: with 'matched_count' characters of the query already matched, 'pattern' is the rest of the query and the match continues from 'inout_pos'
+// 'inout_pos' and 'inout_score' are ignored when starting a match (matched_count == 0), and are only updated on success
+bool FuzzySearchGreedy(const char* pattern, const char* haystack, int matched_count, int max_matches, int& inout_pos, int& inout_score);
+// Highest score FuzzySearchEX can give the pattern over any haystack, which an exact match does not always get (e.g. "_aB" scores more than "ab" for "ab")
+int FuzzySearchScoreCeiling(const char* pattern);
+// Same over haystacks of [min_length, max_length] bytes, without any camel case or separator bonus unless 'word_boundaries' is set
+int FuzzySearchScoreCeiling(const char* pattern, int min_length, int max_length, bool word_boundaries);
 
 template<typename T>
 int DefaultComboAutoSelectSearchCallback(const ComboAutoSelectSearchCallbackData<T>& callback_data);
 template<typename T>
 void DefaultComboFilterSearchCallback(const ComboFilterSearchCallbackData<T>& callback_data);
+// Greedy matching of every item, resumed from the matches of the previous query when it grows (see FindComboResumeState()), for very large lists typed in one character at a time
+// Same matches as the default callback. The best RescoredCount results are scored by FuzzySearchEX, along with every result whose score bound reaches them,
+// so they are the best results of the default callback in the same order. The results after them keep their greedy score, and an approximate order
+template<typename T>
+void IncrementalComboFilterSearchCallback(const ComboFilterSearchCallbackData<T>& callback_data);
+// Same results for a ComboItemSource, but the items its search indexes rule out are skipped before bounding their score
+template<>
+int DefaultComboAutoSelectSearchCallback<const ComboItemSource&>(const ComboAutoSelectSearchCallbackData<const ComboItemSource&>& callback_data);
+template<>
+void DefaultComboFilterSearchCallback<const ComboItemSource&>(const ComboFilterSearchCallbackData<const ComboItemSource&>& callback_data);
+// Prefix mode for a ComboItemSource: selects the first item in case-folded order starting with the query, in O(log N) with its prefix index
+// Falls back to the default (fuzzy) callback when no item starts with the query. The index is built on the first search unless BuildComboItemSourcePrefixIndex() was called
+int PrefixComboAutoSelectSearchCallback(const ComboAutoSelectSearchCallbackData<const ComboItemSource&>& callback_data);
+// Substring search for a ComboItemSource: the items containing the query (ignoring case), in O(|query| log N + hits) with its suffix array
+// The suffix array is built on the first search unless BuildComboItemSourceSuffixIndex() was called, which is worth doing beforehand for large sources
+// Earlier and tighter matches score higher: -2 per character before the match, -1 per unmatched character, +30 at the start of a word
+void SubstringComboFilterSearchCallback(const ComboFilterSearchCallbackData<const ComboItemSource&>& callback_data);
 
 template<typename T1, typename T2, typename = std::enable_if<std::is_convertible<T1, T2>::value>::type>
 bool ComboAutoSelectEX(const char* combo_label, int& selected_item, const T1& items, ComboItemGetterCallback<T2> item_getter, ComboAutoSelectSearchCallback<T2> autoselect_callback, ImGuiComboFlags flags);
 template<typename T1, typename T2, typename = std::enable_if<std::is_convertible<T1, T2>::value>::type>
-bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items, ComboItemGetterCallback<T2> item_getter, ComboFilterSearchCallback<T2> filter_callback, ImGuiComboFlags flags);
+bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items, ComboItemGetterCallback<T2> item_getter, ComboFilterSearchCallback<T2> filter_callback, ImGuiComboFlags flags, const ComboFilterColumn<T2>* columns = NULL, int columns_count = 0);
+template<typename T1, typename T2>
+int RenderComboFilterTableRows(ComboFilterData& combo_data, const T1& items, ComboItemGetterCallback<T2> item_getter, const ComboFilterColumn<T2>* columns, int columns_count, int row_count, ImGuiWindow** out_scroll_window);
 
 } // Internal namespace
 } // ImGui namespace
@@ -153,12 +765,21 @@ struct ComboData
 	char InputText[StringCapacity + 1]{ 0 };
 	struct
 	{
-		const char* Preview;
-		int         Index;
-	} InitialValues{ "", -1 };
+		ImVector<char> Preview;            // Copied, as an item getter may return a buffer it reuses (e.g. ComboDafsa::GetItem())
+		int            Index{ -1 };
+	} InitialValues;
 	int CurrentSelection{ -1 };
+	int LastUsedFrame{ -1 };               // Last frame a widget used this combo data
+	ComboRowHeights RowHeights;            // Only measured with ImGuiComboFlags_VariableHeight
+	ComboVirtualScroll VirtualScroll;      // Only active for very long lists of one line rows
+	ComboDrawCache DrawCache;              // Only recorded with ImGuiComboFlags_RetainDrawCache
+	ImGuiID OwnerWindowID{ 0 };            // Window whose state storage references this combo data, if any. Looked up by ID as the window may be destroyed with its context
+
+	void        SetInitialValues(const char* preview, int index);
+	const char* GetInitialPreview() const noexcept { return InitialValues.Preview.Size > 0 ? InitialValues.Preview.Data : ""; }
 
 	virtual ~ComboData() = default;
+	virtual size_t CalcMemoryUsage() const noexcept; // Bytes owned, including heap allocations
 };
 
 }
@@ -175,13 +796,58 @@ struct ComboFilterData : Internal::ComboData
 {
 	ComboFilterSearchResults FilteredItems;
 	bool FilterStatus{ false };
+	int ItemsVersion{ 0 };                      // Version of the items FilteredItems were searched in, see ComboItemSource
+	Internal::ComboQueryHistory History;
+	ComboFilterRanking Ranking;                 // Of FilteredItems
+	Internal::ComboColumnTextCache ColumnTexts; // Only used by ComboFilterTable
 
+	size_t CalcMemoryUsage() const noexcept override;
 	bool SetNewValue(const char* new_val, int new_index) noexcept;
 	bool SetNewValue(const char* new_val) noexcept;
 	void ResetToInitialValue() noexcept;
 	void ResetAll() noexcept;
 };
 
+// Counters accumulated since the combo was first searched (or since ResetComboPerfCounters())
+// For ComboAutoSelect, a search produces at most one match (the selected item)
+struct ComboPerfCounters
+{
+	static constexpr int LatencyBucketCount = 16; // Bucket 0 counts latencies under 1us, bucket i in [2^(i-1), 2^i) us, the last one everything above
+
+	char      Label[64];                              // Label of the combo when it was first recorded, for reports
+	int       SearchCount{ 0 };                       // Number of search callback invocations
+	long long ItemsScanned{ 0 };                      // Items handed to the search callback
+	long long CandidatesRejected{ 0 };                // Items the search callback did not output
+	long long MatchesProduced{ 0 };                   // Items the search callback did output
+	double    FilterTime{ 0.0 };                      // Seconds spent in the search callback, sort excluded
+	double    SortTime{ 0.0 };                        // Seconds spent in SortFilterResultsDescending/Ascending during searches
+	double    LastFilterTime{ 0.0 };
+	double    LastSortTime{ 0.0 };
+	int       LatencyHistogram[LatencyBucketCount]{}; // Time from the frame a keystroke changed the query to the frame its results were listed
+	double    LatencyMax{ 0.0 };
+	double    SearchStartTime{ 0.0 };                 // Internal, start time of the search being measured
+	double    SortTimeInSearch{ 0.0 };                // Internal, sort time accumulated during the search being measured
+	double    PendingKeystrokeTime{ -1.0 };           // Internal, start time of the latency being measured or negative if none
+};
+
+struct ComboSessionEvent
+{
+	ComboSessionEventType Type;
+	double                Time;         // Seconds since the recording started
+	int                   Value[3];     // Open: widget kind, flags, item count. Select: row index
+	int                   QueryOffset;  // Query: offset of the query in ComboSession::Queries
+	int                   QueryLength;
+};
+
+// A recorded session loaded with LoadComboSession()
+struct ComboSession
+{
+	ImVector<ComboSessionEvent> Events;
+	ImVector<char>              Queries;  // Zero-terminated query strings of the Query events
+
+	const char* GetQuery(const ComboSessionEvent& e) const { return Queries.Data + e.QueryOffset; }
+};
+
 // Result data from a search algorithm
 // Contains the index of the item from list and the score of the item
 struct ComboFilterSearchResultData
@@ -210,6 +876,12 @@ struct ComboFilterSearchCallbackData
 	const char*                SearchString;   // Read-only
 	ComboItemGetterCallback<T> ItemGetter;     // Read-only
 	ComboFilterSearchResults*  FilterResults;  // Output value
+	// Read-only, NULL if none. Results of the longest query searched earlier that the search string starts with
+	// Any item matching a subsequence search of the search string is among them, so such callbacks can search these items only
+	const char*                     PreviousSearchString{ nullptr };
+	const ComboFilterSearchResults* PreviousResults{ nullptr };
+	// Output value, NULL if the caller needs every result in its final order. Only set by callbacks leaving results to be ranked as they are shown
+	ComboFilterRanking*             Ranking{ nullptr };
 };
 
 template<typename T1, typename T2, typename>
@@ -244,6 +916,58 @@ bool ComboFilter(const char* combo_label, int& selected_item, const T1& items, C
 	return ComboFilter(combo_label, selected_item, items, item_getter, Internal::DefaultComboFilterSearchCallback, flags);
 }
 
+template<typename T1, typename T2, typename>
+bool ComboFilterTable(const char* combo_label, int& selected_item, const T1& items, ComboItemGetterCallback<T2> item_getter, const ComboFilterColumn<T2>* columns, int columns_count, ComboFilterSearchCallback<T2> filter_callback, ImGuiComboFlags flags)
+{
+	IM_ASSERT(columns != NULL && columns_count > 0);
+	IM_ASSERT(!(flags & (ImGuiComboFlags_VariableHeight | ImGuiComboFlags_RetainDrawCache)) && "Table rows are always one line tall and drawn by the table");
+	ImGui::BeginDisabled(Internal::IsContainerEmpty(items));
+	auto ret = Internal::ComboFilterEX(combo_label, selected_item, items, item_getter, filter_callback, flags, columns, columns_count);
+	ImGui::EndDisabled();
+
+	return ret;
+}
+
+template<typename T1, typename T2, typename>
+bool ComboFilterTable(const char* combo_label, int& selected_item, const T1& items, ComboItemGetterCallback<T2> item_getter, const ComboFilterColumn<T2>* columns, int columns_count, ImGuiComboFlags flags)
+{
+	return ComboFilterTable(combo_label, selected_item, items, item_getter, columns, columns_count, Internal::DefaultComboFilterSearchCallback, flags);
+}
+
+template<typename T1, typename T2, typename>
+ComboItemSource* RegisterComboItemSource(const char* name, const T1& items, ComboItemGetterCallback<T2> item_getter, ComboItemSourceStorage storage)
+{
+	ComboItemSource* source = Internal::AddComboItemSource(name);
+	source->Storage = storage;
+	Internal::SetComboItemSourceItems(*source, items, item_getter);
+	return source;
+}
+
+template<typename T1, typename T2, typename>
+void UpdateComboItemSource(ComboItemSource* source, const T1& items, ComboItemGetterCallback<T2> item_getter)
+{
+	IM_ASSERT(source != NULL);
+	Internal::SetComboItemSourceItems(*source, items, item_getter);
+}
+
+template<typename T1, typename T2>
+void ComboDafsa::Build(const T1& items, ComboItemGetterCallback<T2> item_getter)
+{
+	// Copied first, the item getter may return a buffer it reuses
+	const int count = static_cast<int>(Internal::GetContainerSize(items));
+	ImVector<char> texts;
+	ImVector<int> offsets;
+	offsets.resize(count);
+	for (int i = 0; i < count; ++i) {
+		const char* text = item_getter(items, i);
+		const int length = static_cast<int>(strlen(text)) + 1;
+		offsets[i] = texts.Size;
+		texts.resize(texts.Size + length);
+		memcpy(texts.Data + offsets[i], text, length);
+	}
+	Build(texts.Data, offsets.Data, count);
+}
+
 namespace Internal
 {
 
@@ -271,6 +995,115 @@ constexpr bool IsContainerEmpty(const T(&array)[N]) noexcept
 	return false;
 }
 
+template<typename T1, typename T2>
+ImGuiID CalcComboItemsSignature(const T1& items, ComboItemGetterCallback<T2> item_getter, int count)
+{
+	ImGuiID signature = ImHashData(&count, sizeof(count));
+	for (int s = 0; s < ComboItemsSignatureSamples && count > 0; ++s) {
+		const int index = static_cast<int>(static_cast<long long>(count - 1) * s / (ComboItemsSignatureSamples - 1));
+		signature = ImHashStr(item_getter(items, index), 0, signature);
+	}
+	return signature;
+}
+
+template<typename T2>
+ImGuiID CalcComboItemsSignature(const ComboItemSource& source, ComboItemGetterCallback<T2>, int count)
+{
+	const int key[3]{ static_cast<int>(source.ID), source.Version, count };
+	return ImHashData(key, sizeof(key));
+}
+
+template<typename T1, typename T2>
+ComboItemWidthCache* UpdateComboItemWidthCache(const T1& items, ComboItemGetterCallback<T2> item_getter, bool validate)
+{
+	ComboItemWidthCache* cache = GetComboItemWidthCache(&items);
+	const int items_count = static_cast<int>(GetContainerSize(items));
+	if (cache->Widths.Size > items_count || (validate && cache->ItemsSignature != CalcComboItemsSignature(items, item_getter, cache->Widths.Size)))
+		cache->Reset();
+
+	// Only the items added since the last call are measured, within the per-frame budget
+	const int measured = cache->Widths.Size;
+	const int end = ImMin(items_count, measured + ComboItemWidthCache::MeasureBudget);
+	if (end > cache->Widths.Size)
+		cache->Widths.reserve(end);
+	for (int i = cache->Widths.Size; i < end; ++i) {
+		const float width = CalcTextSize(item_getter(items, i), NULL, false).x;
+		cache->Widths.push_back(width);
+		cache->MaxWidth = ImMax(cache->MaxWidth, width);
+	}
+	if (end > measured || cache->ItemsSignature == 0)
+		cache->ItemsSignature = CalcComboItemsSignature(items, item_getter, cache->Widths.Size);
+	return cache;
+}
+
+template<typename T1, typename T2>
+const char* CallBorrowedComboItemGetter(const ComboItemSource& source, int index)
+{
+	return reinterpret_cast<ComboItemGetterCallback<T2>>(source.BorrowedGetter)(*static_cast<const T1*>(source.BorrowedItems), index);
+}
+
+template<typename T1, typename T2>
+void SetComboItemSourceItems(ComboItemSource& source, const T1& items, ComboItemGetterCallback<T2> item_getter)
+{
+	source.Count = static_cast<int>(GetContainerSize(items));
+	if (source.Storage == ComboItemSourceStorage_Owned) {
+		source.OwnedTexts.resize(0);
+		source.OwnedOffsets.resize(source.Count);
+		for (int i = 0; i < source.Count; ++i) {
+			const char* text = item_getter(items, i);
+			const int length = static_cast<int>(strlen(text)) + 1;
+			source.OwnedOffsets[i] = source.OwnedTexts.Size;
+			source.OwnedTexts.resize(source.OwnedTexts.Size + length);
+			memcpy(source.OwnedTexts.Data + source.OwnedOffsets[i], text, length);
+		}
+	}
+	else if (source.Storage == ComboItemSourceStorage_Dafsa) {
+		source.Dafsa.Build(items, item_getter);
+	}
+	else {
+		source.BorrowedItems = &items;
+		source.BorrowedGetter = reinterpret_cast<void (*)()>(item_getter);
+		source.BorrowedThunk = CallBorrowedComboItemGetter<T1, T2>;
+	}
+	OnComboItemSourceChanged(source);
+}
+
+template<typename F>
+void RefineComboFilterResults(ComboFilterSearchResults& results, ComboFilterRanking& ranking, int min_exact_count, const char* query, F&& item_text)
+{
+	constexpr int max_matches = 128;
+	unsigned char matches[max_matches];
+	int match_count;
+	const int count = static_cast<int>(results.size());
+	min_exact_count = ImMin(min_exact_count, count);
+	while (ranking.ExactCount >= 0 && ranking.ExactCount < min_exact_count) {
+		// The batches grow with the scored results that are not final yet, so merging them back stays linear overall
+		const int batch = ImMax(ImMax(min_exact_count - ranking.ExactCount, ranking.ScoredCount - ranking.ExactCount), ComboFilterRanking::RefineMargin);
+		const int scored_end = ImMin(count, ranking.ScoredCount + batch);
+		for (int i = ranking.ScoredCount; i < scored_end; ++i)
+			FuzzySearchEX(query, item_text(results[i].Index), results[i].Score, matches, max_matches, match_count);
+		MergeComboFilterResults(results, ranking.ExactCount, ranking.ScoredCount, scored_end);
+		ranking.ScoredCount = scored_end;
+
+		// Scored results are final once they outrank the upper bound of every result left, which are sorted by upper bound
+		if (scored_end == count) {
+			ranking.ExactCount = ranking.ScoredCount = -1;
+			break;
+		}
+		const int next_upper_bound = results[scored_end].Score;
+		while (ranking.ExactCount < scored_end && results[ranking.ExactCount].Score > next_upper_bound)
+			++ranking.ExactCount;
+	}
+}
+
+template<typename T1, typename T2>
+void RefineComboFilterRows(ComboFilterData& combo_data, const T1& items, ComboItemGetterCallback<T2> item_getter, int row_end)
+{
+	if (!combo_data.FilterStatus || combo_data.Ranking.IsFinal(row_end))
+		return;
+	RefineComboFilterResults(combo_data.FilteredItems, combo_data.Ranking, row_end + ComboFilterRanking::RefineMargin, combo_data.InputText, [&](int index) { return item_getter(items, index); });
+}
+
 template<typename T>
 int DefaultComboAutoSelectSearchCallback(const ComboAutoSelectSearchCallbackData<T>& callback_data)
 {
@@ -278,53 +1111,144 @@ int DefaultComboAutoSelectSearchCallback(const ComboAutoSelectSearchCallbackData
 		return -1;
 
 	const int item_count = static_cast<int>(Internal::GetContainerSize(callback_data.Items));
+	const int score_ceiling = FuzzySearchScoreCeiling(callback_data.SearchString);
 	constexpr int max_matches = 128;
 	unsigned char matches[max_matches];
 	int best_item = -1;
-	int prevmatch_count;
 	int match_count;
-	int best_score;
+	int best_score = 0;
+	int upper_bound;
 	int score;
-	int i = 0;
 
-	for (; i < item_count; ++i) {
-		if (FuzzySearchEX(callback_data.SearchString, callback_data.ItemGetter(callback_data.Items, i), score, matches, max_matches, match_count)) {
-			prevmatch_count = match_count;
-			best_score = score;
-			best_item = i;
+	// Every match has the whole query matched, so the first item with the highest score is selected
+	// Branch and bound: FuzzySearchEX only runs on the items whose upper bound beats the best score so far,
+	// and the search stops once no item can beat it
+	for (int i = 0; i < item_count; ++i) {
+		const char* item_text = callback_data.ItemGetter(callback_data.Items, i);
+		if (!FuzzySearchScoreUpperBound(callback_data.SearchString, item_text, max_matches, upper_bound) || (best_item >= 0 && upper_bound <= best_score))
+			continue;
+		if (!FuzzySearchEX(callback_data.SearchString, item_text, score, matches, max_matches, match_count) || (best_item >= 0 && score <= best_score))
+			continue;
+		best_score = score;
+		best_item = i;
+		if (best_score >= score_ceiling)
 			break;
+	}
+
+	return best_item;
+}
+
+template<typename T>
+void DefaultComboFilterSearchCallback(const ComboFilterSearchCallbackData<T>& callback_data)
+{
+	// Phase 1: a single pass over every item gives the matches and an upper bound of their score
+	const int item_count = static_cast<int>(GetContainerSize(callback_data.Items));
+	constexpr int max_matches = 128;
+	int upper_bound;
+
+	if (callback_data.PreviousResults) {
+		ImVector<int> candidates;
+		GetComboNarrowedCandidates(*callback_data.PreviousResults, candidates);
+		for (int i : candidates) {
+			if (FuzzySearchScoreUpperBound(callback_data.SearchString, callback_data.ItemGetter(callback_data.Items, i), max_matches, upper_bound)) {
+				callback_data.FilterResults->emplace_back(i, upper_bound);
+			}
 		}
 	}
-	for (; i < item_count; ++i) {
-		if (FuzzySearchEX(callback_data.SearchString, callback_data.ItemGetter(callback_data.Items, i), score, matches, max_matches, match_count)) {
-			if ((score > best_score && prevmatch_count >= match_count) || (score == best_score && match_count > prevmatch_count)) {
-				prevmatch_count = match_count;
-				best_score = score;
-				best_item = i;
+	else {
+		for (int i = 0; i < item_count; ++i) {
+			if (FuzzySearchScoreUpperBound(callback_data.SearchString, callback_data.ItemGetter(callback_data.Items, i), max_matches, upper_bound)) {
+				callback_data.FilterResults->emplace_back(i, upper_bound);
 			}
 		}
 	}
+	SortFilterResultsDescending(*callback_data.FilterResults);
 
-	return best_item;
+	// Phase 2: FuzzySearchEX only scores the best candidates, the rest are scored as they are shown (or right away if the caller cannot do that)
+	ComboFilterRanking ranking{ 0, 0 };
+	const int exact_count = callback_data.Ranking ? ComboFilterRanking::InitialExactCount : static_cast<int>(callback_data.FilterResults->size());
+	RefineComboFilterResults(*callback_data.FilterResults, ranking, exact_count, callback_data.SearchString, [&](int index) { return callback_data.ItemGetter(callback_data.Items, index); });
+	if (callback_data.Ranking)
+		*callback_data.Ranking = ranking;
 }
 
 template<typename T>
-void DefaultComboFilterSearchCallback(const ComboFilterSearchCallbackData<T>& callback_data)
+void IncrementalComboFilterSearchCallback(const ComboFilterSearchCallbackData<T>& callback_data)
 {
-	const int item_count = static_cast<int>(GetContainerSize(callback_data.Items));
+	constexpr int RescoredCount = 256; // More than the rows a popup shows
 	constexpr int max_matches = 128;
-	unsigned char matches[max_matches];
-	int best_item = -1;
+	ComboFilterSearchResults& results = *callback_data.FilterResults;
+	const char* query = callback_data.SearchString;
+	auto item_text = [&](int index) { return callback_data.ItemGetter(callback_data.Items, index); };
+	const int item_count = static_cast<int>(GetContainerSize(callback_data.Items));
+	const ImGuiID items_signature = CalcComboItemsSignature(callback_data.Items, callback_data.ItemGetter, item_count);
+
+	// Phase 1: greedy match of the candidates, in index order
+	ImVector<ComboResumeMatch> matches;
+	const ImVector<ComboResumeMatch>* previous = callback_data.PreviousResults ? FindComboResumeState(CalcComboResumeStateKey(items_signature, callback_data.PreviousSearchString)) : NULL;
+	if (previous && previous->Size == static_cast<int>(callback_data.PreviousResults->size())) {
+		const int matched_count = static_cast<int>(strlen(callback_data.PreviousSearchString));
+		for (ComboResumeMatch match : *previous)
+			if (FuzzySearchGreedy(query + matched_count, item_text(match.Index), matched_count, max_matches, match.Pos, match.Score))
+				matches.push_back(match);
+	}
+	else {
+		auto match_item = [&](int i) {
+			ComboResumeMatch match{ i, 0, 0 };
+			if (FuzzySearchGreedy(query, item_text(i), 0, max_matches, match.Pos, match.Score))
+				matches.push_back(match);
+		};
+		if (callback_data.PreviousResults) {
+			ImVector<int> candidates;
+			GetComboNarrowedCandidates(*callback_data.PreviousResults, candidates);
+			for (int i : candidates)
+				match_item(i);
+		}
+		else {
+			for (int i = 0; i < item_count; ++i)
+				match_item(i);
+		}
+	}
+	results.reserve(results.size() + matches.Size);
+	for (const ComboResumeMatch& match : matches)
+		results.push_back({ match.Index, match.Score });
+	AddComboResumeState(CalcComboResumeStateKey(items_signature, query), matches);
+
+	// Phase 2: the greedy score is a lower bound, the best results are scored again
+	SortFilterResultsDescending(results);
+	const int result_count = static_cast<int>(results.size());
+	int rescored_count = ImMin(result_count, RescoredCount);
+	unsigned char match_positions[max_matches];
 	int match_count;
-	int score = 0;
+	int threshold = 0;
+	for (int i = 0; i < rescored_count; ++i) {
+		FuzzySearchEX(query, item_text(results[i].Index), results[i].Score, match_positions, max_matches, match_count);
+		threshold = i == 0 ? results[i].Score : ImMin(threshold, results[i].Score);
+	}
 
-	for (int i = 0; i < item_count; ++i) {
-		if (FuzzySearchEX(callback_data.SearchString, callback_data.ItemGetter(callback_data.Items, i), score, matches, max_matches, match_count)) {
-			callback_data.FilterResults->emplace_back(i, score);
+	// Any other result reaching the lowest of them is scored too. FuzzySearchEX scores at most 45 more per query character than the greedy match
+	// (a camel case or separator bonus, a sequential bonus, and the leading letters penalty back), which bounds the results to check in greedy order
+	if (rescored_count < result_count) {
+		const int max_gain = 45 * static_cast<int>(strlen(query));
+		ImVector<ComboFilterSearchResultData> passed;
+		int upper_bound;
+		int i = rescored_count;
+		for (; i < result_count && results[i].Score + max_gain >= threshold; ++i) {
+			ComboFilterSearchResultData result = results[i];
+			if (FuzzySearchScoreUpperBound(query, item_text(result.Index), max_matches, upper_bound) && upper_bound >= threshold) {
+				FuzzySearchEX(query, item_text(result.Index), result.Score, match_positions, max_matches, match_count);
+				results[rescored_count++] = result;
+			}
+			else {
+				passed.push_back(result);
+			}
 		}
+		for (int j = 0; j < passed.Size; ++j) // The results passed over keep their greedy order
+			results[rescored_count + j] = passed[j];
 	}
 
-	SortFilterResultsDescending(*callback_data.FilterResults);
+	// Ties in index order, like the stable sort of the default callback
+	MergeComboFilterResults(results, 0, 0, rescored_count);
 }
 
 template<typename T1, typename T2, typename>
@@ -356,10 +1280,10 @@ bool ComboAutoSelectEX(const char* combo_label, int& selected_item, const T1& it
 	if (!ItemAdd(total_bb, combo_id, &bb))
 		return false;
 
-	ComboAutoSelectData* combo_data = GetComboData<ComboAutoSelectData>(combo_id);
-	if (!combo_data) {
-		combo_data = AddComboData<ComboAutoSelectData>(combo_id);
-	}
+	// The combo data is only created when the popup is first opened, until then the preview comes from selected_item
+	ComboAutoSelectData* combo_data = FindComboData<ComboAutoSelectData>(window, combo_id);
+	if (combo_data)
+		combo_data->LastUsedFrame = g.FrameCount;
 
 	// Open on click
 	bool hovered, held;
@@ -373,6 +1297,7 @@ bool ComboAutoSelectEX(const char* combo_label, int& selected_item, const T1& it
 			OpenPopupEx(combo_id);
 			popupIsAlreadyOpened = true;
 			popupJustOpened = true;
+			RecordComboSessionOpen(combo_id, 1, flags, static_cast<int>(GetContainerSize(items)));
 		}
 		const ImU32 frame_col = GetColorU32(hovered ? ImGuiCol_FrameBgHovered : ImGuiCol_FrameBg);
 		RenderNavHighlight(bb, combo_id);
@@ -389,15 +1314,11 @@ bool ComboAutoSelectEX(const char* combo_label, int& selected_item, const T1& it
 
 	if (!popupIsAlreadyOpened) {
 		RenderFrameBorder(bb.Min, bb.Max, style.FrameRounding);
-		if (combo_data->InitialValues.Preview != NULL && !(flags & ImGuiComboFlags_NoPreview)) {
-			RenderTextClipped(
-				ImVec2(bb.Min.x + style.FramePadding.x, bb.Min.y + style.FramePadding.y),
-				ImVec2(value_x2, bb.Max.y),
-				combo_data->InitialValues.Preview,
-				NULL,
-				NULL,
-				ImVec2(0.0f, 0.0f)
-			);
+		const char* preview = combo_data ? combo_data->GetInitialPreview() : selected_item >= 0 ? item_getter(items, selected_item) : NULL;
+		if (preview != NULL && !(flags & ImGuiComboFlags_NoPreview)) {
+			// Only the preview is measured while closed, the width cache is checked against the items when the popup opens
+			const float preview_width = (flags & ImGuiComboFlags_AutoWidth) ? CalcTextSize(preview, NULL, false).x : -1.0f;
+			RenderComboPreview(ImRect(bb.Min.x + style.FramePadding.x, bb.Min.y + style.FramePadding.y, value_x2, bb.Max.y), preview, preview_width);
 		}
 	}
 
@@ -406,8 +1327,19 @@ bool ComboAutoSelectEX(const char* combo_label, int& selected_item, const T1& it
 	if (!popupIsAlreadyOpened)
 		return false;
 
+	if (!combo_data) {
+		combo_data = AddComboData<ComboAutoSelectData>(window, combo_id);
+		combo_data->LastUsedFrame = g.FrameCount;
+		if (selected_item >= 0)
+			combo_data->SetNewValue(item_getter(items, selected_item), selected_item);
+	}
+
+	IMGUI_COMBO_TRACE_BEGIN(ComboTracePhase_PopupSetup, combo_id);
 	PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(3.50f, 5.00f));
-	const float popup_width = flags & (ImGuiComboFlags_NoPreview | ImGuiComboFlags_NoArrowButton) ? expected_w : w - arrow_size;
+	const ComboItemWidthCache* width_cache = (flags & ImGuiComboFlags_AutoWidth) ? UpdateComboItemWidthCache(items, item_getter, popupJustOpened) : NULL;
+	float popup_width = flags & (ImGuiComboFlags_NoPreview | ImGuiComboFlags_NoArrowButton) ? expected_w : w - arrow_size;
+	if (width_cache)
+		popup_width = CalcComboAutoPopupWidth(popup_width, width_cache->MaxWidth);
 	int popup_item_count = -1;
 	if (!(g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasSizeConstraint)) {
 		if ((flags & ImGuiComboFlags_HeightMask_) == 0)
@@ -447,9 +1379,11 @@ bool ComboAutoSelectEX(const char* combo_label, int& selected_item, const T1& it
 	if (!Begin(name, NULL, window_flags)) {
 		PopStyleVar();
 		EndPopup();
+		IMGUI_COMBO_TRACE_END(ComboTracePhase_PopupSetup, combo_id);
 		IM_ASSERT(0);   // This should never happen as we tested for IsPopupOpen() above
 		return false;
 	}
+	IMGUI_COMBO_TRACE_END(ComboTracePhase_PopupSetup, combo_id);
 
 	if (popupJustOpened) {
 		SetKeyboardFocusHere(0);
@@ -478,63 +1412,103 @@ bool ComboAutoSelectEX(const char* combo_label, int& selected_item, const T1& it
 		ImGuiWindow* listbox_window = ImGui::GetCurrentWindow();
 		listbox_window->Flags |= ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus;
 
-		ImGuiListClipper list_clipper;
-		list_clipper.Begin(items_count);
-		char select_item_id[128];
-		while (list_clipper.Step()) {
-			for (int n = list_clipper.DisplayStart; n < list_clipper.DisplayEnd; n++) {
-				bool is_selected = n == combo_data->CurrentSelection;
-				const char* select_value = item_getter(items, n);
-
-				// allow empty item / in case of duplicate item name on different index
-				ImFormatString(select_item_id, sizeof(select_item_id), "%s##item_%02d", select_value, n);
-				if (Selectable(select_item_id, is_selected)) {
-					if (combo_data->SetNewValue(select_value, n)) {
-						selection_changed = true;
-						SetScrollToComboItemJump(listbox_window, n);
-						selected_item = combo_data->CurrentSelection;
-					}
-					CloseCurrentPopup();
-				}
+		IMGUI_COMBO_TRACE_BEGIN(ComboTracePhase_Clipper, combo_id);
+		const ComboRowHeights* row_heights = NULL;
+		auto row_label = [&](int n) { return item_getter(items, n); };
+		auto measure_row = [&](int row, bool scroll_to) {
+			if (row_heights)
+				combo_data->RowHeights.MeasureAbove(row, scroll_to ? listbox_window->InnerRect.GetHeight() : 0.0f, row_label);
+		};
+		const ComboVirtualScroll* virtual_scroll = NULL;
+		const int row_count = (flags & ImGuiComboFlags_VariableHeight) ? ClampComboListedRows(items_count) : items_count;
+		if (flags & ImGuiComboFlags_VariableHeight) {
+			combo_data->RowHeights.Update(row_count);
+			combo_data->RowHeights.MeasureRange(listbox_window->Scroll.y, listbox_window->Scroll.y + listbox_window->InnerRect.GetHeight(), row_label);
+			row_heights = &combo_data->RowHeights;
+			ClearComboVirtualScroll(combo_data->VirtualScroll, listbox_window);
+		}
+		else {
+			virtual_scroll = UpdateComboVirtualScroll(combo_data->VirtualScroll, listbox_window, items_count);
+		}
+		const ComboListRows rows = BeginComboListRows(row_count, row_heights, virtual_scroll);
+		ComboDrawCache* draw_cache = (flags & ImGuiComboFlags_RetainDrawCache) ? &combo_data->DrawCache : NULL;
+		const ImGuiID draw_signature = draw_cache ? CalcComboDrawSignature(rows, row_count, combo_data->CurrentSelection, combo_data->InputText, items_count, GetContainerVersion(items), width_cache ? width_cache->Widths.Size : 0) : 0;
+		if (!draw_cache || !draw_cache->Replay(draw_signature, rows)) {
+			if (draw_cache)
+				draw_cache->BeginRecord();
+			ComboListClipper list_clipper;
+			list_clipper.Begin(rows, row_count);
+			while (list_clipper.Step()) {
+				for (int n = list_clipper.DisplayStart; n < list_clipper.DisplayEnd; n++)
+					RenderComboListRow(rows, n, item_getter(items, n), n == combo_data->CurrentSelection, width_cache ? width_cache->GetWidth(n) : -1.0f);
+			}
+			if (draw_cache)
+				draw_cache->EndRecord(draw_signature, rows);
+		}
+		if (rows.PressedRow >= 0) {
+			const int n = rows.PressedRow;
+			RecordComboSessionEvent(combo_id, ComboSessionEvent_Select, n);
+			if (combo_data->SetNewValue(item_getter(items, n), n)) {
+				selection_changed = true;
+				SetScrollToComboItemJump(listbox_window, n, row_heights);
+				selected_item = combo_data->CurrentSelection;
 			}
+			CloseCurrentPopup();
 		}
+		IMGUI_COMBO_TRACE_END(ComboTracePhase_Clipper, combo_id);
+		RecordComboPerfResultsShown(combo_id);
 
 		if (clicked_outside || IsKeyPressed(ImGuiKey_Escape)) { // Resets the selection to it's initial value if the user exits the combo (clicking outside the combo or the combo arrow button)
+			RecordComboSessionEvent(combo_id, clicked_outside ? ComboSessionEvent_Close : ComboSessionEvent_Escape);
 			if (combo_data->CurrentSelection != combo_data->InitialValues.Index)
 				combo_data->ResetToInitialValue();
-			if (combo_data->InitialValues.Index < 0)
+			if (combo_data->InitialValues.Index < 0) {
 				SetScrollY(0.0f);
-			else
-				SetScrollToComboItemJump(listbox_window, combo_data->InitialValues.Index);
+			}
+			else {
+				measure_row(combo_data->InitialValues.Index, true);
+				SetScrollToComboItemJump(listbox_window, combo_data->InitialValues.Index, row_heights);
+			}
 			CloseCurrentPopup();
 		}
 		else if (buffer_changed) {
+			RecordComboSessionQuery(combo_id, combo_data->InputText);
+			IMGUI_COMBO_TRACE_SCOPE(ComboTracePhase_Search, combo_id);
+			ComboPerfCounters* perf_counters = BeginComboPerfSearch(combo_id, combo_label);
 			combo_data->CurrentSelection = autoselect_callback({ items, combo_data->InputText, item_getter });
-			if (combo_data->CurrentSelection < 0)
+			EndComboPerfSearch(perf_counters, items_count, combo_data->CurrentSelection < 0 ? 0 : 1);
+			if (combo_data->CurrentSelection < 0) {
 				SetScrollY(0.0f);
-			else
-				SetScrollToComboItemJump(listbox_window, combo_data->CurrentSelection);
+			}
+			else {
+				measure_row(combo_data->CurrentSelection, true);
+				SetScrollToComboItemJump(listbox_window, combo_data->CurrentSelection, row_heights);
+			}
 		}
 		else if (IsKeyPressed(ImGuiKey_Enter) || IsKeyPressed(ImGuiKey_KeypadEnter)) { // Automatically exit the combo popup on selection
+			RecordComboSessionEvent(combo_id, ComboSessionEvent_Enter);
 			if (combo_data->SetNewValue(item_getter(items, combo_data->CurrentSelection))) {
 				selection_changed = true;
-				SetScrollToComboItemJump(listbox_window, combo_data->CurrentSelection);
+				SetScrollToComboItemJump(listbox_window, combo_data->CurrentSelection, row_heights);
 				selected_item = combo_data->CurrentSelection;
 			}
 			CloseCurrentPopup();
 		}
 
 		if (IsKeyPressed(ImGuiKey_UpArrow)) {
+			RecordComboSessionEvent(combo_id, ComboSessionEvent_Up);
 			if (combo_data->CurrentSelection > 0)
 			{
-				SetScrollToComboItemUp(listbox_window, --combo_data->CurrentSelection);
+				SetScrollToComboItemUp(listbox_window, --combo_data->CurrentSelection, row_heights);
 				UpdateInputTextAndCursor(combo_data->InputText, ComboData::StringCapacity, item_getter(items, combo_data->CurrentSelection));
 			}
 		}
 		else if (IsKeyPressed(ImGuiKey_DownArrow)) {
-			if (combo_data->CurrentSelection >= -1 && combo_data->CurrentSelection < items_count - 1)
+			RecordComboSessionEvent(combo_id, ComboSessionEvent_Down);
+			if (combo_data->CurrentSelection >= -1 && combo_data->CurrentSelection < row_count - 1)
 			{
-				SetScrollToComboItemDown(listbox_window, ++combo_data->CurrentSelection);
+				measure_row(combo_data->CurrentSelection + 1, false);
+				SetScrollToComboItemDown(listbox_window, ++combo_data->CurrentSelection, row_heights);
 				UpdateInputTextAndCursor(combo_data->InputText, ComboData::StringCapacity, item_getter(items, combo_data->CurrentSelection));
 			}
 		}
@@ -547,8 +1521,75 @@ bool ComboAutoSelectEX(const char* combo_label, int& selected_item, const T1& it
 	return selection_changed;
 }
 
+template<typename T1, typename T2>
+int RenderComboFilterTableRows(ComboFilterData& combo_data, const T1& items, ComboItemGetterCallback<T2> item_getter, const ComboFilterColumn<T2>* columns, int columns_count, int row_count, ImGuiWindow** out_scroll_window)
+{
+	// Same row height as the list rows (headers included), so the scroll helpers work on tables too
+	const ImGuiStyle& style = GetStyle();
+	const float row_height = GetFontSize() + style.ItemSpacing.y;
+	PushStyleVar(ImGuiStyleVar_CellPadding, ImVec2(style.CellPadding.x, IM_FLOOR(style.ItemSpacing.y * 0.50f)));
+	int pressed_row = -1;
+	constexpr ImGuiTableFlags table_flags = ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_NoSavedSettings | ImGuiTableFlags_ScrollY;
+	if (BeginTable("##combo_table", columns_count, table_flags)) {
+		*out_scroll_window = GetCurrentWindow(); // The table scrolls its own window, under the headers
+		for (int c = 0; c < columns_count; ++c)
+			TableSetupColumn(columns[c].Label, columns[c].InitWidth > 0.0f ? ImGuiTableColumnFlags_WidthFixed : ImGuiTableColumnFlags_WidthStretch, columns[c].InitWidth);
+		TableSetupScrollFreeze(0, 1);
+		TableNextRow(ImGuiTableRowFlags_Headers, row_height);
+		for (int c = 0; c < columns_count; ++c) {
+			if (!TableSetColumnIndex(c))
+				continue;
+			PushID(c);
+			TableHeader(TableGetColumnName(c));
+			PopID();
+		}
+
+		combo_data.ColumnTexts.Validate(GetContainerVersion(items), static_cast<int>(GetContainerSize(items)));
+		char score_buf[16];
+		ImGuiListClipper clipper;
+		clipper.Begin(row_count, row_height);
+		while (clipper.Step()) {
+			RefineComboFilterRows(combo_data, items, item_getter, clipper.DisplayEnd);
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row) {
+				const int item_index = combo_data.FilterStatus ? combo_data.FilteredItems[row].Index : row;
+				TableNextRow(ImGuiTableRowFlags_None, row_height);
+				for (int c = 0; c < columns_count; ++c) {
+					TableSetColumnIndex(c);
+					const char* text;
+					if (columns[c].Getter == NULL) {
+						text = score_buf;
+						if (combo_data.FilterStatus)
+							ImFormatString(score_buf, IM_ARRAYSIZE(score_buf), "%d", combo_data.FilteredItems[row].Score);
+						else
+							score_buf[0] = '\0';
+					}
+					else if (columns[c].Getter == item_getter) {
+						text = item_getter(items, item_index);
+					}
+					else if ((text = combo_data.ColumnTexts.Find(item_index, c)) == NULL) {
+						text = combo_data.ColumnTexts.Add(item_index, c, columns[c].Getter(items, item_index));
+					}
+
+					if (c == 0) {
+						PushID(row);
+						if (Selectable(text, row == combo_data.CurrentSelection, ImGuiSelectableFlags_SpanAllColumns))
+							pressed_row = row;
+						PopID();
+					}
+					else {
+						TextUnformatted(text);
+					}
+				}
+			}
+		}
+		EndTable();
+	}
+	PopStyleVar();
+	return pressed_row;
+}
+
 template<typename T1, typename T2, typename>
-bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items, ComboItemGetterCallback<T2> item_getter, ComboFilterSearchCallback<T2> filter_callback, ImGuiComboFlags flags)
+bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items, ComboItemGetterCallback<T2> item_getter, ComboFilterSearchCallback<T2> filter_callback, ImGuiComboFlags flags, const ComboFilterColumn<T2>* columns, int columns_count)
 {
 	ImGuiContext* g = GImGui;
 	ImGuiWindow* window = GetCurrentWindow();
@@ -575,11 +1616,10 @@ bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items,
 	if (!ItemAdd(total_bb, combo_id, &bb))
 		return false;
 
-	ComboFilterData* combo_data = GetComboData<ComboFilterData>(combo_id);
-	if (!combo_data) {
-		combo_data = AddComboData<ComboFilterData>(combo_id);
-		combo_data->FilteredItems.reserve(GetContainerSize(items) / 2);
-	}
+	// The combo data is only created when the popup is first opened, until then the preview comes from selected_item
+	ComboFilterData* combo_data = FindComboData<ComboFilterData>(window, combo_id);
+	if (combo_data)
+		combo_data->LastUsedFrame = g->FrameCount;
 
 	// Open on click
 	bool hovered, held;
@@ -591,6 +1631,7 @@ bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items,
 		OpenPopupEx(combo_id, ImGuiPopupFlags_None);
 		popup_open = true;
 		popup_just_opened = true;
+		RecordComboSessionOpen(combo_id, 0, flags, static_cast<int>(GetContainerSize(items)));
 	}
 
 	// Render shape
@@ -610,16 +1651,36 @@ bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items,
 	RenderFrameBorder(bb.Min, bb.Max, style.FrameRounding);
 
 	// Render preview and label
-	if (combo_data->InitialValues.Preview != NULL && !(flags & ImGuiComboFlags_NoPreview)) {
-		const ImVec2 min_pos(bb.Min.x + style.FramePadding.x, bb.Min.y + style.FramePadding.y);
-		RenderTextClipped(min_pos, ImVec2(value_x2, bb.Max.y), combo_data->InitialValues.Preview, NULL, NULL);
+	const char* preview = combo_data ? combo_data->GetInitialPreview() : selected_item >= 0 ? item_getter(items, selected_item) : NULL;
+	if (preview != NULL && !(flags & ImGuiComboFlags_NoPreview)) {
+		const float preview_width = (flags & ImGuiComboFlags_AutoWidth) ? CalcTextSize(preview, NULL, false).x : -1.0f;
+		RenderComboPreview(ImRect(bb.Min.x + style.FramePadding.x, bb.Min.y + style.FramePadding.y, value_x2, bb.Max.y), preview, preview_width);
 	}
 	if (label_size.x > 0)
 		RenderText(ImVec2(bb.Max.x + style.ItemInnerSpacing.x, bb.Min.y + style.FramePadding.y), combo_label);
 	if (!popup_open)
 		return false;
 
+	if (!combo_data) {
+		combo_data = AddComboData<ComboFilterData>(window, combo_id);
+		combo_data->LastUsedFrame = g->FrameCount;
+		combo_data->FilteredItems.reserve(GetContainerSize(items) / 2);
+		combo_data->ItemsVersion = GetContainerVersion(items);
+		if (selected_item >= 0)
+			combo_data->SetNewValue(item_getter(items, selected_item), selected_item);
+	}
+
+	IMGUI_COMBO_TRACE_BEGIN(ComboTracePhase_PopupSetup, combo_id);
 	PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(3.50f, 5.00f));
+	const ComboItemWidthCache* width_cache = (flags & ImGuiComboFlags_AutoWidth) ? UpdateComboItemWidthCache(items, item_getter, popup_just_opened) : NULL;
+	float popup_width = width_cache ? CalcComboAutoPopupWidth(expected_w, width_cache->MaxWidth) : expected_w;
+	if (columns) {
+		// Fixed width columns are added to the combo width, which is left to the stretched ones
+		float fixed_columns_width = 0.0f;
+		for (int c = 0; c < columns_count; ++c)
+			fixed_columns_width += columns[c].InitWidth;
+		popup_width = ImMax(popup_width, ImMin(expected_w + fixed_columns_width, GetMainViewport()->WorkSize.x));
+	}
 	int popup_item_count = -1;
 	if (!(g->NextWindowData.Flags & ImGuiNextWindowDataFlags_HasSizeConstraint)) {
 		if ((flags & ImGuiComboFlags_HeightMask_) == 0)
@@ -629,7 +1690,7 @@ bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items,
 		else if (flags & ImGuiComboFlags_HeightSmall) popup_item_count = 4 + 1;
 		else if (flags & ImGuiComboFlags_HeightLarge) popup_item_count = 20 + 1;
 		const float popup_height = CalcComboItemHeight(popup_item_count, 5.0f); // Increment popup_item_count to account for the InputText widget
-		SetNextWindowSizeConstraints(ImVec2(0.0f, 0.0f), ImVec2(expected_w, popup_height));
+		SetNextWindowSizeConstraints(ImVec2(0.0f, 0.0f), ImVec2(popup_width, popup_height));
 	}
 
 	char name[16];
@@ -651,15 +1712,17 @@ bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items,
 	if (!Begin(name, NULL, window_flags)) {
 		PopStyleVar();
 		EndPopup();
+		IMGUI_COMBO_TRACE_END(ComboTracePhase_PopupSetup, combo_id);
 		IM_ASSERT(0);   // This should never happen as we tested for IsPopupOpen() above
 		return false;
 	}
+	IMGUI_COMBO_TRACE_END(ComboTracePhase_PopupSetup, combo_id);
 
 	if (popup_just_opened) {
 		SetKeyboardFocusHere();
 	}
 
-	const float items_max_width = expected_w - (style.WindowPadding.x * 2.00f);
+	const float items_max_width = popup_width - (style.WindowPadding.x * 2.00f);
 	PushItemWidth(items_max_width);
 	PushStyleVar(ImGuiStyleVar_FrameRounding, 5.00f);
 	PushStyleColor(ImGuiCol_FrameBg, (ImVec4)ImColor(240, 240, 240, 255));
@@ -671,12 +1734,18 @@ bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items,
 
 	bool selection_changed     = false;
 	const bool clicked_outside = !IsWindowHovered(ImGuiHoveredFlags_AllowWhenBlockedByActiveItem | ImGuiHoveredFlags_AnyWindow) && IsMouseClicked(0);
+	const bool items_changed   = combo_data->ItemsVersion != GetContainerVersion(items); // The results are searched again in the new items
+	combo_data->ItemsVersion   = GetContainerVersion(items);
 
 	auto item_getter2 = [&](int index) -> const char* {
 		return item_getter(items, combo_data->FilterStatus ? combo_data->FilteredItems[index].Index : index);
 	};
+	auto item_width2 = [&](int index) -> float {
+		return width_cache ? width_cache->GetWidth(combo_data->FilterStatus ? combo_data->FilteredItems[index].Index : index) : -1.0f;
+	};
 
-	const int item_count = static_cast<int>(combo_data->FilterStatus ? GetContainerSize(combo_data->FilteredItems) : GetContainerSize(items));
+	const int result_count = static_cast<int>(combo_data->FilterStatus ? GetContainerSize(combo_data->FilteredItems) : GetContainerSize(items));
+	const int item_count = (flags & ImGuiComboFlags_VariableHeight) || columns ? ClampComboListedRows(result_count) : result_count;
 	char listbox_name[16];
 	ImFormatString(listbox_name, 16, "##lbn%u", combo_id);
 	if (--popup_item_count > item_count || popup_item_count < 0)
@@ -685,40 +1754,116 @@ bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items,
 		ImGuiWindow* listbox_window = ImGui::GetCurrentWindow();
 		listbox_window->Flags |= ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus;
 
-		if (listbox_window->Appearing)
-			SetScrollToComboItemJump(listbox_window, combo_data->InitialValues.Index);
-
-		ImGuiListClipper listclipper;
-		listclipper.Begin(item_count);
-		char select_item_id[128];
-		while (listclipper.Step()) {
-			for (int i = listclipper.DisplayStart; i < listclipper.DisplayEnd; ++i) {
-				bool is_selected = i == combo_data->CurrentSelection;
-				const char* select_value = item_getter2(i);
-
-				ImFormatString(select_item_id, 128, "%s##id%d", select_value, i);
-				if (Selectable(select_item_id, is_selected)) {
-					if (combo_data->SetNewValue(select_value, i)) {
-						selection_changed = true;
-						selected_item = combo_data->CurrentSelection;
-					}
-					CloseCurrentPopup();
+		const ComboRowHeights* row_heights = NULL;
+		auto measure_row = [&](int row, bool scroll_to) {
+			if (row_heights)
+				combo_data->RowHeights.MeasureAbove(row, scroll_to ? listbox_window->InnerRect.GetHeight() : 0.0f, item_getter2);
+		};
+		const ComboVirtualScroll* virtual_scroll = NULL;
+		if (flags & ImGuiComboFlags_VariableHeight) {
+			const float visible_end = listbox_window->Scroll.y + listbox_window->InnerRect.GetHeight();
+			combo_data->RowHeights.Update(item_count);
+			RefineComboFilterRows(*combo_data, items, item_getter, combo_data->RowHeights.FindRow(visible_end) + 1); // Rows are measured in their final order
+			combo_data->RowHeights.MeasureRange(listbox_window->Scroll.y, visible_end, item_getter2);
+			row_heights = &combo_data->RowHeights;
+		}
+		if (!(flags & ImGuiComboFlags_VariableHeight) && !columns)
+			virtual_scroll = UpdateComboVirtualScroll(combo_data->VirtualScroll, listbox_window, item_count);
+		else
+			ClearComboVirtualScroll(combo_data->VirtualScroll, listbox_window);
+		// A table scrolls its rows in its own window, under the frozen headers row
+		ImGuiWindow* scroll_window = listbox_window;
+		const int header_rows = columns ? 1 : 0;
+
+		if (listbox_window->Appearing && !columns) {
+			measure_row(combo_data->InitialValues.Index, true);
+			SetScrollToComboItemJump(listbox_window, combo_data->InitialValues.Index, row_heights);
+		}
+
+		IMGUI_COMBO_TRACE_BEGIN(ComboTracePhase_Clipper, combo_id);
+		int pressed_row = -1;
+		if (columns) {
+			pressed_row = RenderComboFilterTableRows(*combo_data, items, item_getter, columns, columns_count, item_count, &scroll_window);
+			if (listbox_window->Appearing)
+				SetScrollToComboItemJump(scroll_window, combo_data->InitialValues.Index + header_rows);
+		}
+		else {
+			const ComboListRows rows = BeginComboListRows(item_count, row_heights, virtual_scroll);
+			ComboDrawCache* draw_cache = (flags & ImGuiComboFlags_RetainDrawCache) ? &combo_data->DrawCache : NULL;
+			const ImGuiID draw_signature = draw_cache ? CalcComboDrawSignature(rows, item_count, combo_data->CurrentSelection, combo_data->InputText, static_cast<int>(GetContainerSize(items)), GetContainerVersion(items), width_cache ? width_cache->Widths.Size : 0) : 0;
+			if (!draw_cache || !draw_cache->Replay(draw_signature, rows)) {
+				if (draw_cache)
+					draw_cache->BeginRecord();
+				ComboListClipper listclipper;
+				listclipper.Begin(rows, item_count);
+				while (listclipper.Step()) {
+					RefineComboFilterRows(*combo_data, items, item_getter, listclipper.DisplayEnd);
+					for (int i = listclipper.DisplayStart; i < listclipper.DisplayEnd; ++i)
+						RenderComboListRow(rows, i, item_getter2(i), i == combo_data->CurrentSelection, item_width2(i));
 				}
+				if (draw_cache)
+					draw_cache->EndRecord(draw_signature, rows);
 			}
+			pressed_row = rows.PressedRow;
 		}
+		if (pressed_row >= 0) {
+			const int i = pressed_row;
+			RecordComboSessionEvent(combo_id, ComboSessionEvent_Select, i);
+			if (combo_data->SetNewValue(item_getter2(i), i)) {
+				selection_changed = true;
+				selected_item = combo_data->CurrentSelection;
+			}
+			CloseCurrentPopup();
+		}
+		IMGUI_COMBO_TRACE_END(ComboTracePhase_Clipper, combo_id);
+		RecordComboPerfResultsShown(combo_id);
 
 		if (clicked_outside || IsKeyPressed(ImGuiKey_Escape)) {
+			RecordComboSessionEvent(combo_id, clicked_outside ? ComboSessionEvent_Close : ComboSessionEvent_Escape);
 			combo_data->ResetToInitialValue();
 			CloseCurrentPopup();
 		}
-		else if (buffer_changed) {
+		else if (buffer_changed || items_changed) {
+			if (buffer_changed)
+				RecordComboSessionQuery(combo_id, combo_data->InputText);
 			combo_data->FilteredItems.clear();
-			if (combo_data->FilterStatus = combo_data->InputText[0] != '\0')
-				filter_callback({ items, combo_data->InputText, item_getter, &combo_data->FilteredItems });
+			combo_data->RowHeights.Invalidate();
+			if (combo_data->FilterStatus = combo_data->InputText[0] != '\0') {
+				IMGUI_COMBO_TRACE_SCOPE(ComboTracePhase_Search, combo_id);
+				const int items_version = GetContainerVersion(items); // Only versioned items are cached
+				const ImGuiID engine_id = ImHashData(&item_getter, sizeof(item_getter), ImHashData(&filter_callback, sizeof(filter_callback))); // Results depend on the texts the getter returns too
+				ComboQueryHistory& history = combo_data->History;
+				history.Validate(engine_id, CalcComboItemsSignature(items, item_getter, static_cast<int>(GetContainerSize(items))));
+				history.Truncate(combo_data->InputText);
+				const ComboQueryHistory::Entry* previous = history.GetLast();
+				combo_data->Ranking = ComboFilterRanking();
+				if (previous && strcmp(previous->Query.Data, combo_data->InputText) == 0) {
+					combo_data->FilteredItems = previous->Results; // Back to a shorter query
+					combo_data->Ranking = previous->Ranking;
+				}
+				else {
+					if (items_version == 0 || !FindComboCachedResults(&items, items_version, engine_id, combo_data->InputText, combo_data->FilteredItems, combo_data->Ranking)) {
+						ComboFilterSearchCallbackData<T2> callback_data{ items, combo_data->InputText, item_getter, &combo_data->FilteredItems };
+						callback_data.Ranking = &combo_data->Ranking;
+						if (previous) {
+							callback_data.PreviousSearchString = previous->Query.Data;
+							callback_data.PreviousResults = &previous->Results;
+						}
+						ComboPerfCounters* perf_counters = BeginComboPerfSearch(combo_id, combo_label);
+						filter_callback(callback_data);
+						EndComboPerfSearch(perf_counters, previous ? static_cast<int>(GetContainerSize(previous->Results)) : static_cast<int>(GetContainerSize(items)), static_cast<int>(GetContainerSize(combo_data->FilteredItems)));
+						if (items_version != 0)
+							AddComboCachedResults(&items, items_version, engine_id, combo_data->InputText, combo_data->FilteredItems, combo_data->Ranking);
+					}
+					history.Push(combo_data->InputText, combo_data->FilteredItems, combo_data->Ranking);
+				}
+			}
 			combo_data->CurrentSelection = GetContainerSize(combo_data->FilteredItems) != 0 ? 0 : -1;
-			SetScrollY(0.0f);
+			SetScrollY(scroll_window, 0.0f);
 		}
 		else if (IsKeyPressed(ImGuiKey_Enter) || IsKeyPressed(ImGuiKey_KeypadEnter)) { // Automatically exit the combo popup on selection
+			RecordComboSessionEvent(combo_id, ComboSessionEvent_Enter);
+			RefineComboFilterRows(*combo_data, items, item_getter, combo_data->CurrentSelection + 1);
 			if (combo_data->SetNewValue(combo_data->CurrentSelection < 0 ? item_getter(items, -1) : item_getter2(combo_data->CurrentSelection))) {
 				selection_changed = true;
 				selected_item = combo_data->CurrentSelection;
@@ -727,13 +1872,18 @@ bool ComboFilterEX(const char* combo_label, int& selected_item, const T1& items,
 		}
 
 		if (IsKeyPressed(ImGuiKey_UpArrow)) {
+			RecordComboSessionEvent(combo_id, ComboSessionEvent_Up);
 			if (combo_data->CurrentSelection > 0) {
-				SetScrollToComboItemUp(listbox_window, --combo_data->CurrentSelection);
+				--combo_data->CurrentSelection;
+				SetScrollToComboItemUp(scroll_window, combo_data->CurrentSelection, row_heights); // The headers do not scroll, so a row reaching the top is under them
 			}
 		}
 		else if (IsKeyPressed(ImGuiKey_DownArrow)) {
+			RecordComboSessionEvent(combo_id, ComboSessionEvent_Down);
 			if (combo_data->CurrentSelection >= -1 && combo_data->CurrentSelection < item_count - 1) {
-				SetScrollToComboItemDown(listbox_window, ++combo_data->CurrentSelection);
+				measure_row(combo_data->CurrentSelection + 1, false);
+				++combo_data->CurrentSelection;
+				SetScrollToComboItemDown(scroll_window, combo_data->CurrentSelection + header_rows, row_heights);
 			}
 		}
 
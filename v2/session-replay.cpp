@@ -0,0 +1,389 @@
+// Headless replay of a combo session recorded with StartComboSessionRecording()/StopComboSessionRecording()
+// Every recorded event is turned back into the input that produced it (clicks, typed characters, backspaces, keys) and the frames it takes are timed,
+// so "it stutters when I type mat_ in the material picker" can be reproduced exactly, and compared with the timings of a previous build
+// The timings are printed as CSV, one line per event. Save them as a baseline and pass it on the next run to catch regressions:
+// the program exits with 1 if an event got slower than the baseline by more than the tolerance (a ratio, 1.25 by default)
+//
+// Build it together with the Dear ImGui core sources, no backend is needed:
+//   c++ -std=c++20 -O2 -I<imgui> session-replay.cpp imgui-combo-filter.cpp <imgui>/imgui.cpp <imgui>/imgui_draw.cpp <imgui>/imgui_tables.cpp <imgui>/imgui_widgets.cpp -o session-replay
+// Usage:
+//   session-replay <session_file> <items> [baseline_csv] [tolerance]
+// Items are read from a text file with one item per line, or generated with "corpus:<identifiers|words|paths|symbols|utf8>:<count>"
+// The items and the display size should match the recording for Select events to click the same rows
+// The first frame of every event is given the time recorded since the previous event (io.DeltaTime), so timers and double clicks behave as recorded
+
+#include "imgui-combo-filter.h"
+#include "benchmark-common.h"
+#include "synthetic-corpus.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <span>
+#include <string>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------------------------
+// ITEMS
+//----------------------------------------------------------------------------------------------------------------------
+
+static const char* item_getter(std::span<const std::string> items, int index)
+{
+    if (index >= 0 && index < (int)items.size()) {
+        return items[index].c_str();
+    }
+    return "";
+}
+
+static bool LoadItems(const char* spec, std::vector<std::string>& out_items)
+{
+    char name[32];
+    int count = 0;
+    if (sscanf(spec, "corpus:%31[^:]:%d", name, &count) == 2) {
+        if (strcmp(name, "identifiers") == 0)  out_items = SyntheticCorpus::GenerateIdentifiers(count);
+        else if (strcmp(name, "words") == 0)   out_items = SyntheticCorpus::GenerateWords(count);
+        else if (strcmp(name, "paths") == 0)   out_items = SyntheticCorpus::GenerateFilePaths(count);
+        else if (strcmp(name, "symbols") == 0) out_items = SyntheticCorpus::GenerateSymbols(count);
+        else if (strcmp(name, "utf8") == 0)    out_items = SyntheticCorpus::GenerateMixedUtf8(count);
+        else return false;
+        return true;
+    }
+
+    FILE* file = fopen(spec, "rb");
+    if (!file)
+        return false;
+    std::string line;
+    for (int c = fgetc(file); c != EOF; c = fgetc(file)) {
+        if (c == '\n') {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+            out_items.push_back(std::move(line));
+            line.clear();
+        }
+        else {
+            line += static_cast<char>(c);
+        }
+    }
+    if (!line.empty())
+        out_items.push_back(std::move(line));
+    fclose(file);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// REPLAY
+//----------------------------------------------------------------------------------------------------------------------
+
+struct EventTimings
+{
+    int    Frames = 0;
+    double FrameTotal = 0.0;
+    double FrameMax = 0.0;
+    double SearchTotal = 0.0; // Search callback and sort, from the perf counters
+};
+
+static constexpr const char* WindowLabel = "Replay";
+static constexpr const char* ComboLabel = "##replay_combo";
+
+struct Replayer
+{
+    const std::vector<std::string>& Items;
+    int                             WidgetKind;
+    ImGuiComboFlags                 Flags;
+    int                             SelectedItem = -1;
+    ImRect                          ComboRect;
+    bool                            PopupOpen = false;
+    bool                            CursorAtEnd = true; // False when the input text may have a selection or a moved cursor
+    EventTimings*                   Timings = NULL; // Timings of the event being replayed, NULL while setting up
+    double                          NextDeltaTime = 0.0; // Recorded time since the previous event, given to the next frame
+
+    Replayer(const std::vector<std::string>& items, int widget_kind, ImGuiComboFlags flags) : Items(items), WidgetKind(widget_kind), Flags(flags) {}
+
+    void RunFrame()
+    {
+        const double search_time_before = GetSearchTime();
+        const double t0 = Benchmark::GetTimeSeconds();
+
+        // The frames of an event are 1/60 s apart, the first one comes after the time the user actually waited
+        ImGui::GetIO().DeltaTime = NextDeltaTime > 1.0 / 60.0 ? static_cast<float>(NextDeltaTime) : 1.0f / 60.0f;
+        NextDeltaTime = 0.0;
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0.0f, 0.0f));
+        ImGui::SetNextWindowSize(ImGui::GetIO().DisplaySize);
+        ImGui::Begin(WindowLabel, nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings);
+        if (WidgetKind == 0)
+            ImGui::ComboFilter(ComboLabel, SelectedItem, Items, item_getter, Flags);
+        else
+            ImGui::ComboAutoSelect(ComboLabel, SelectedItem, Items, item_getter, Flags);
+        ComboRect = ImRect(ImGui::GetItemRectMin(), ImGui::GetItemRectMax());
+        ImGui::End();
+        ImGui::Render();
+
+        const double frame_time = Benchmark::GetTimeSeconds() - t0;
+        if (Timings) {
+            Timings->Frames += 1;
+            Timings->FrameTotal += frame_time;
+            Timings->FrameMax = frame_time > Timings->FrameMax ? frame_time : Timings->FrameMax;
+            Timings->SearchTotal += GetSearchTime() - search_time_before;
+        }
+    }
+
+    double GetSearchTime() const
+    {
+        if (!ImGui::FindWindowByName(WindowLabel))
+            return 0.0;
+        const ImGui::ComboPerfCounters* counters = ImGui::GetComboPerfCounters(WindowLabel, ComboLabel);
+        return counters ? counters->FilterTime + counters->SortTime : 0.0;
+    }
+
+    // Input events are queued before the frame processing them, and every press is followed by a release frame
+    void Click(const ImVec2& pos)
+    {
+        Benchmark::QueueMouseClick(pos, true);
+        RunFrame();
+        Benchmark::QueueMouseClick(pos, false);
+        RunFrame();
+    }
+
+    void PressKey(ImGuiKey key)
+    {
+        Benchmark::QueueKeyPress(key, true);
+        RunFrame();
+        Benchmark::QueueKeyPress(key, false);
+        RunFrame();
+    }
+
+    void TypeCharacter(unsigned int c)
+    {
+        Benchmark::QueueCharacter(c);
+        RunFrame();
+        RunFrame();
+    }
+
+    void Open()
+    {
+        if (PopupOpen)
+            return;
+        Click(ImVec2((ComboRect.Min.x + ComboRect.Max.x) * 0.5f, (ComboRect.Min.y + ComboRect.Max.y) * 0.5f));
+        PopupOpen = true;
+        CursorAtEnd = false; // The whole input text is selected when the popup opens
+    }
+
+    ImGuiID GetComboID() const
+    {
+        return ImGui::FindWindowByName(WindowLabel)->GetID(ComboLabel);
+    }
+
+    const ImGui::Internal::ComboData* GetComboData() const
+    {
+        const ImGuiID combo_id = GetComboID();
+        return WidgetKind == 0
+            ? static_cast<const ImGui::Internal::ComboData*>(ImGui::Internal::GetComboData<ImGui::ComboFilterData>(combo_id))
+            : static_cast<const ImGui::Internal::ComboData*>(ImGui::Internal::GetComboData<ImGui::ComboAutoSelectData>(combo_id));
+    }
+
+    std::string GetInputText() const
+    {
+        const ImGui::Internal::ComboData* combo_data = GetComboData();
+        return combo_data ? combo_data->InputText : "";
+    }
+
+    // Erases the characters after the common prefix and types the new ones
+    void SetQuery(const std::string& query)
+    {
+        const std::string current = GetInputText();
+        if (!CursorAtEnd && !current.empty())
+            PressKey(ImGuiKey_End); // Moves the cursor to the end and drops the selection
+        CursorAtEnd = true;
+
+        size_t prefix = 0;
+        while (prefix < query.size() && prefix < current.size() && query[prefix] == current[prefix])
+            ++prefix;
+        while (prefix > 0 && (static_cast<unsigned char>(current[prefix]) & 0xC0) == 0x80)
+            --prefix; // Don't split a UTF-8 sequence
+        for (int n = ImTextCountCharsFromUtf8(current.c_str() + prefix, current.c_str() + current.size()); n > 0; --n)
+            PressKey(ImGuiKey_Backspace);
+
+        const char* end = query.c_str() + query.size();
+        for (const char* p = query.c_str() + prefix; p < end;) {
+            unsigned int c;
+            p += ImTextCharFromUtf8(&c, p, end);
+            TypeCharacter(c);
+        }
+    }
+
+    // Clicks the row of the list box, scrolling to it first if it is not visible
+    void SelectRow(int row)
+    {
+        // The popup opened by the combo, whatever its depth in the popup stack and so its window name
+        const ImGuiContext& g = *ImGui::GetCurrentContext();
+        const ImGuiID combo_id = GetComboID();
+        ImGuiWindow* popup_window = NULL;
+        for (const ImGuiPopupData& popup : g.OpenPopupStack)
+            if (popup.PopupId == combo_id)
+                popup_window = popup.Window;
+        ImGuiWindow* listbox_window = popup_window && popup_window->DC.ChildWindows.Size > 0 ? popup_window->DC.ChildWindows[0] : NULL;
+        const ImGui::Internal::ComboData* combo_data = GetComboData();
+        if (!listbox_window || !combo_data)
+            return;
+
+        // Rows are measured by the widget with ImGuiComboFlags_VariableHeight, and one line tall otherwise
+        const ImGuiStyle& style = ImGui::GetStyle();
+        const ImGui::Internal::ComboRowHeights* heights = (Flags & ImGui::ImGuiComboFlags_VariableHeight) ? &combo_data->RowHeights : NULL;
+        const float row_height = ImGui::GetFontSize() + style.ItemSpacing.y;
+        auto row_center_y = [&]() {
+            // Virtually scrolled rows are positioned from the top row, their content positions would not fit in a float
+            const ImGui::Internal::ComboVirtualScroll& virtual_scroll = combo_data->VirtualScroll;
+            if (virtual_scroll.Active)
+                return virtual_scroll.ViewTop + static_cast<float>(row - virtual_scroll.TopRow) * row_height + ImGui::GetFontSize() * 0.5f;
+            const float row_top = heights && row < heights->RowCount ? heights->GetTop(row) : row_height * row;
+            return listbox_window->DC.CursorStartPos.y + row_top + ImGui::GetFontSize() * 0.5f;
+        };
+        if (row_center_y() < listbox_window->InnerClipRect.Min.y || row_center_y() >= listbox_window->InnerClipRect.Max.y) {
+            ImGui::Internal::SetScrollToComboItemJump(listbox_window, row, heights);
+            RunFrame(); // Scrolls, and measures the rows shown around the row
+        }
+        Click(ImVec2(listbox_window->InnerClipRect.Min.x + style.FramePadding.x, row_center_y()));
+    }
+
+    void Replay(const ImGui::ComboSession& session, const ImGui::ComboSessionEvent& e, double previous_event_time)
+    {
+        NextDeltaTime = e.Time - previous_event_time;
+        if (e.Type != ImGui::ComboSessionEvent_Open)
+            Open(); // Recordings started while the popup was open have no Open event
+
+        switch (e.Type) {
+        case ImGui::ComboSessionEvent_Open:   Open(); break;
+        case ImGui::ComboSessionEvent_Close:  Click(ImVec2(ImGui::GetIO().DisplaySize.x - 1.0f, ImGui::GetIO().DisplaySize.y - 1.0f)); PopupOpen = false; break;
+        case ImGui::ComboSessionEvent_Query:  SetQuery(session.GetQuery(e)); break;
+        case ImGui::ComboSessionEvent_Up:     PressKey(ImGuiKey_UpArrow); CursorAtEnd = WidgetKind == 0; break;    // ComboAutoSelect replaces the input text
+        case ImGui::ComboSessionEvent_Down:   PressKey(ImGuiKey_DownArrow); CursorAtEnd = WidgetKind == 0; break;
+        case ImGui::ComboSessionEvent_Enter:  PressKey(ImGuiKey_Enter); PopupOpen = false; break;
+        case ImGui::ComboSessionEvent_Escape: PressKey(ImGuiKey_Escape); PopupOpen = false; break;
+        case ImGui::ComboSessionEvent_Select: SelectRow(e.Value[0]); PopupOpen = false; break;
+        default: break;
+        }
+    }
+};
+
+static std::vector<EventTimings> ReplaySession(const ImGui::ComboSession& session, const std::vector<std::string>& items, int widget_kind, ImGuiComboFlags flags)
+{
+    Benchmark::HeadlessContext context;
+    ImGui::SetComboPerfCountersEnabled(true);
+    ImGui::ResetComboPerfCounters();
+
+    Replayer replayer(items, widget_kind, flags);
+    replayer.RunFrame();
+    replayer.RunFrame();
+
+    std::vector<EventTimings> timings(session.Events.Size);
+    for (int i = 0; i < session.Events.Size; ++i) {
+        replayer.Timings = &timings[i];
+        replayer.Replay(session, session.Events[i], i > 0 ? session.Events[i - 1].Time : 0.0);
+    }
+    replayer.Timings = NULL;
+
+    ImGui::ClearComboData(WindowLabel, ComboLabel);
+    return timings;
+}
+
+//----------------------------------------------------------------------------------------------------------------------
+// BASELINE
+//----------------------------------------------------------------------------------------------------------------------
+
+// Reads the frame_ms column of a CSV previously printed by this program
+static bool LoadBaseline(const char* filename, std::vector<double>& out_frame_ms)
+{
+    FILE* file = fopen(filename, "rb");
+    if (!file)
+        return false;
+    char line[512];
+    while (fgets(line, sizeof(line), file)) {
+        int index, frames;
+        char type[32];
+        double frame_ms;
+        if (sscanf(line, "%d,%31[^,],%d,%lf", &index, type, &frames, &frame_ms) == 4)
+            out_frame_ms.push_back(frame_ms);
+    }
+    fclose(file);
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: session-replay <session_file> <items> [baseline_csv] [tolerance]\n");
+        return 2;
+    }
+    const char* baseline_file = argc > 3 ? argv[3] : NULL;
+    const double tolerance = argc > 4 ? atof(argv[4]) : 1.25;
+    constexpr double min_regression_ms = 0.5; // Below this difference an event is never reported, frames that short are mostly noise
+    constexpr int repeats = 3;
+
+    ImGui::ComboSession session;
+    if (!ImGui::LoadComboSession(argv[1], session)) {
+        fprintf(stderr, "could not load session '%s'\n", argv[1]);
+        return 2;
+    }
+    std::vector<std::string> items;
+    if (!LoadItems(argv[2], items)) {
+        fprintf(stderr, "could not load items '%s'\n", argv[2]);
+        return 2;
+    }
+
+    int widget_kind = 0;
+    ImGuiComboFlags flags = ImGuiComboFlags_None;
+    for (const ImGui::ComboSessionEvent& e : session.Events) {
+        if (e.Type == ImGui::ComboSessionEvent_Open) {
+            widget_kind = e.Value[0];
+            flags = e.Value[1];
+            if (e.Value[2] != static_cast<int>(items.size()))
+                fprintf(stderr, "warning: recorded with %d items, replaying with %d\n", e.Value[2], static_cast<int>(items.size()));
+            break;
+        }
+    }
+
+    // The replay is deterministic, so the best of a few runs is kept for every event to filter out noise
+    std::vector<EventTimings> best = ReplaySession(session, items, widget_kind, flags);
+    for (int r = 1; r < repeats; ++r) {
+        const std::vector<EventTimings> timings = ReplaySession(session, items, widget_kind, flags);
+        for (size_t i = 0; i < best.size(); ++i) {
+            if (timings[i].FrameTotal < best[i].FrameTotal)
+                best[i] = timings[i];
+        }
+    }
+
+    std::vector<double> baseline;
+    if (baseline_file && !LoadBaseline(baseline_file, baseline)) {
+        fprintf(stderr, "could not load baseline '%s'\n", baseline_file);
+        return 2;
+    }
+    if (baseline_file && baseline.size() != best.size())
+        fprintf(stderr, "warning: baseline has %d events, session has %d\n", static_cast<int>(baseline.size()), static_cast<int>(best.size()));
+
+    int regressions = 0;
+    double total = 0.0, baseline_total = 0.0;
+    printf("event,type,frames,frame_ms,frame_max_ms,search_ms,recorded_time_s\n");
+    for (size_t i = 0; i < best.size(); ++i) {
+        const ImGui::ComboSessionEvent& e = session.Events[static_cast<int>(i)];
+        const EventTimings& t = best[i];
+        const double frame_ms = t.FrameTotal * 1e3;
+        printf("%d,%s,%d,%.4f,%.4f,%.4f,%.6f\n", static_cast<int>(i), ImGui::GetComboSessionEventName(e.Type), t.Frames, frame_ms, t.FrameMax * 1e3, t.SearchTotal * 1e3, e.Time);
+
+        total += frame_ms;
+        if (i < baseline.size()) {
+            baseline_total += baseline[i];
+            if (frame_ms > baseline[i] * tolerance && frame_ms - baseline[i] > min_regression_ms) {
+                fprintf(stderr, "regression: event %d (%s) took %.3f ms, baseline %.3f ms\n", static_cast<int>(i), ImGui::GetComboSessionEventName(e.Type), frame_ms, baseline[i]);
+                ++regressions;
+            }
+        }
+    }
+
+    fprintf(stderr, "%d events, %.3f ms total", static_cast<int>(best.size()), total);
+    if (baseline_file)
+        fprintf(stderr, ", baseline %.3f ms, %d regressions", baseline_total, regressions);
+    fprintf(stderr, "\n");
+
+    return regressions == 0 ? 0 : 1;
+}
@@ -0,0 +1,197 @@
+// Deterministic synthetic item lists used by the benchmarks
+// Every generator is seeded so the same call always produces the same list, on every platform
+
+#pragma once
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace SyntheticCorpus
+{
+
+// Small and fast PRNG (splitmix64) so results do not depend on the standard library implementation
+struct Random
+{
+    uint64_t State;
+
+    explicit Random(uint64_t seed) : State(seed) {}
+
+    uint64_t Next()
+    {
+        uint64_t z = (State += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    int Range(int max_exclusive)
+    {
+        return static_cast<int>(Next() % static_cast<uint64_t>(max_exclusive));
+    }
+};
+
+static const char* const Syllables[]{ "mat", "ste", "el", "pla", "te", "tex", "ture", "ro", "ugh", "ness", "nor", "mal", "al", "be", "do", "spec", "u", "lar", "me", "tal", "gla", "ss", "wo", "od", "con", "crete", "ru", "st", "pa", "int" };
+
+template<size_t N>
+inline const char* Pick(Random& rng, const char* const (&list)[N])
+{
+    return list[rng.Range(static_cast<int>(N))];
+}
+
+// Identifier-like items such as "mat_steel_plate_0042"
+inline std::vector<std::string> GenerateIdentifiers(int count, uint64_t seed = 1)
+{
+    Random rng(seed);
+    std::vector<std::string> items;
+    items.reserve(count);
+
+    char number[16];
+    for (int i = 0; i < count; ++i) {
+        std::string item;
+        const int word_count = 1 + rng.Range(3);
+        for (int w = 0; w < word_count; ++w) {
+            if (w > 0)
+                item += '_';
+            const int syllable_count = 1 + rng.Range(3);
+            for (int s = 0; s < syllable_count; ++s)
+                item += Pick(rng, Syllables);
+        }
+        snprintf(number, sizeof(number), "_%04d", rng.Range(10000));
+        item += number;
+        items.push_back(std::move(item));
+    }
+
+    return items;
+}
+
+static const char* const Words[]{
+    "able", "about", "account", "acid", "across", "addition", "adjustment", "advertisement", "after", "again", "against", "agreement", "air", "amount",
+    "amusement", "angle", "animal", "answer", "apparatus", "approval", "argument", "army", "attack", "attempt", "attention", "attraction", "authority",
+    "balance", "base", "behaviour", "belief", "birth", "bit", "bite", "blood", "blow", "body", "brass", "bread", "breath", "brother", "building", "burn",
+    "burst", "business", "butter", "canvas", "care", "cause", "chalk", "chance", "change", "cloth", "coal", "colour", "comfort", "committee", "company",
+    "comparison", "competition", "condition", "connection", "control", "cook", "copper", "copy", "cork", "cotton", "cough", "country", "cover", "crack",
+    "credit", "crime", "crush", "cry", "current", "curve", "damage", "danger", "daughter", "day", "death", "debt", "decision", "degree", "design",
+    "desire", "destruction", "detail", "development", "digestion", "direction", "discovery", "discussion", "disease", "disgust", "distance", "distribution",
+    "division", "doubt", "drink", "driving", "dust", "earth", "edge", "education", "effect", "end", "error", "event", "example", "exchange", "existence",
+    "expansion", "experience", "expert", "fact", "fall", "family", "father", "fear", "feeling", "fiction", "fire", "flame", "flight", "flower", "fold",
+    "food", "force", "form", "friend", "front", "fruit", "glass", "gold", "government", "grain", "grass", "grip", "group", "growth", "guide", "harbour",
+    "harmony", "hate", "hearing", "heat", "help", "history", "hole", "hope", "hour", "humour", "ice", "idea", "impulse", "increase", "industry", "ink",
+    "insect", "instrument", "insurance", "interest", "invention", "iron", "jelly", "join", "journey", "judge", "jump", "kick", "kiss", "knowledge",
+    "land", "language", "laugh", "law", "lead", "learning", "leather", "letter", "level", "lift", "light", "limit", "linen", "liquid", "list", "look",
+    "loss", "love", "machine", "man", "manager", "mark", "market", "mass", "meal", "measure", "meat", "meeting", "memory", "metal", "middle", "milk",
+    "mind", "mine", "minute", "mist", "money", "month", "morning", "mother", "motion", "mountain", "move", "music", "name", "nation", "need", "news",
+    "night", "noise", "note", "number", "observation", "offer", "oil", "operation", "opinion", "order", "organization", "ornament", "owner", "page",
+    "pain", "paint", "paper", "part", "paste", "payment", "peace", "person", "place", "plant", "play", "pleasure", "point", "poison", "polish", "porter",
+    "position", "powder", "power", "price", "print", "process", "produce", "profit", "property", "prose", "protest", "pull", "punishment", "purpose",
+    "push", "quality", "question", "rain", "range", "rate", "ray", "reaction", "reading", "reason", "record", "regret", "relation", "religion",
+};
+
+static const char* const PathDirectories[]{ "src", "include", "engine", "render", "audio", "physics", "ui", "core", "platform", "tools", "editor", "assets", "shaders", "textures", "materials", "tests", "third_party", "network", "scripting", "animation" };
+static const char* const PathExtensions[]{ ".cpp", ".h", ".hpp", ".inl", ".glsl", ".hlsl", ".png", ".json", ".mat", ".txt" };
+static const char* const SymbolNamespaces[]{ "std", "ImGui", "Engine", "Render", "Physics", "Audio", "Detail", "Internal", "Net", "Editor" };
+
+// Mixed-script fragments, each one is a complete UTF-8 sequence so generated items are always valid UTF-8
+static const char* const Utf8Fragments[]{
+    "caf\xC3\xA9", "na\xC3\xAFve", "\xC3\xBC" "ber", "stra\xC3\x9F" "e", "\xC3\xA5ngstr\xC3\xB6m", "se\xC3\xB1or",
+    "\xD0\xBC\xD0\xB8\xD1\x80", "\xD0\xB4\xD0\xBE\xD0\xBC", "\xD0\xBA\xD0\xBE\xD1\x82",
+    "\xCE\xB1\xCE\xB2\xCE\xB3", "\xCE\xBB\xCF\x8C\xCE\xB3\xCE\xBF\xCF\x82",
+    "\xE6\x97\xA5\xE6\x9C\xAC", "\xE4\xB8\xAD\xE6\x96\x87", "\xE6\x9D\xB1\xE4\xBA\xAC",
+    "\xED\x95\x9C\xEA\xB5\xAD", "\xF0\x9F\x99\x82",
+};
+
+// Plain English words, sometimes joined by a space
+inline std::vector<std::string> GenerateWords(int count, uint64_t seed = 2)
+{
+    Random rng(seed);
+    std::vector<std::string> items;
+    items.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        std::string item = Pick(rng, Words);
+        if (rng.Range(4) == 0) {
+            item += ' ';
+            item += Pick(rng, Words);
+        }
+        items.push_back(std::move(item));
+    }
+    return items;
+}
+
+// Project file paths such as "src/engine/render/shadow_pass.cpp"
+inline std::vector<std::string> GenerateFilePaths(int count, uint64_t seed = 3)
+{
+    Random rng(seed);
+    std::vector<std::string> items;
+    items.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        std::string item;
+        const int depth = 1 + rng.Range(4);
+        for (int d = 0; d < depth; ++d) {
+            item += Pick(rng, PathDirectories);
+            item += '/';
+        }
+        item += Pick(rng, Words);
+        if (rng.Range(2) == 0) {
+            item += '_';
+            item += Pick(rng, Words);
+        }
+        item += Pick(rng, PathExtensions);
+        items.push_back(std::move(item));
+    }
+    return items;
+}
+
+// C++ symbol names mixing CamelCase types and camelCase/snake_case members, such as "Render::ShadowPass::updateCascade"
+inline std::vector<std::string> GenerateSymbols(int count, uint64_t seed = 4)
+{
+    Random rng(seed);
+    std::vector<std::string> items;
+    items.reserve(count);
+    auto append_camel = [&](std::string& out, int word_count, bool capitalize_first) {
+        for (int w = 0; w < word_count; ++w) {
+            std::string word = Pick(rng, Words);
+            if (w > 0 || capitalize_first)
+                word[0] = static_cast<char>(word[0] - 'a' + 'A');
+            out += word;
+        }
+    };
+
+    for (int i = 0; i < count; ++i) {
+        std::string item = Pick(rng, SymbolNamespaces);
+        item += "::";
+        append_camel(item, 1 + rng.Range(3), true);
+        item += "::";
+        if (rng.Range(2) == 0) {
+            append_camel(item, 1 + rng.Range(3), false);
+        }
+        else {
+            item += Pick(rng, Words);
+            item += '_';
+            item += Pick(rng, Words);
+        }
+        items.push_back(std::move(item));
+    }
+    return items;
+}
+
+// ASCII words mixed with Latin-1, Cyrillic, Greek, CJK, Hangul and emoji fragments
+inline std::vector<std::string> GenerateMixedUtf8(int count, uint64_t seed = 5)
+{
+    Random rng(seed);
+    std::vector<std::string> items;
+    items.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        std::string item;
+        const int part_count = 1 + rng.Range(3);
+        for (int p = 0; p < part_count; ++p) {
+            if (p > 0)
+                item += ' ';
+            item += rng.Range(2) == 0 ? Pick(rng, Words) : Pick(rng, Utf8Fragments);
+        }
+        items.push_back(std::move(item));
+    }
+    return items;
+}
+
+} // SyntheticCorpus namespace